@@ -0,0 +1,140 @@
+/**
+ * @file cvector_bench.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief benchmarks for #cvector operations.
+ *
+ * Usage: csc-bench [number of elements]
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cvector.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static double _now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static void _fill_random(int* data, size_t n)
+{
+    unsigned seed = 12345;
+    for (size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (int)seed;
+    }
+}
+
+static void _report(const char* name, size_t n, double seconds)
+{
+    printf("%-32s n=%-10zu %10.3f ms %8.2f ns/elem\n", name, n, seconds * 1e3, (seconds * 1e9) / (double)n);
+}
+
+static void _bench_sort(size_t n)
+{
+    int* input = malloc(n * sizeof(int));
+    int* copy = malloc(n * sizeof(int));
+    if (input == NULL || copy == NULL) {
+        fputs("couldn't allocate benchmark input\n", stderr);
+        exit(1);
+    }
+    _fill_random(input, n);
+
+    // baseline: libc qsort.
+    memcpy(copy, input, n * sizeof(int));
+    double start = _now();
+    qsort(copy, n, sizeof(int), csc_cmp_int);
+    _report("qsort", n, _now() - start);
+
+    // introsort on inline storage.
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+    csc_cvector_add_n(v, input, n);
+    start = _now();
+    csc_cvector_sort(v, csc_cmp_int);
+    _report("csc_cvector_sort", n, _now() - start);
+    csc_cvector_destroy(v);
+
+    // parallel introsort and merge on inline storage.
+    v = csc_cvector_create_sized(sizeof(int));
+    csc_cvector_add_n(v, input, n);
+    start = _now();
+    csc_cvector_parallel_sort(v, csc_cmp_int, 0);
+    _report("csc_cvector_parallel_sort", n, _now() - start);
+    csc_cvector_destroy(v);
+
+    // radix sort on inline storage.
+    v = csc_cvector_create_sized(sizeof(int));
+    csc_cvector_add_n(v, input, n);
+    start = _now();
+    csc_cvector_sort_int(v);
+    _report("csc_cvector_sort_int", n, _now() - start);
+
+    // sanity check against the baseline.
+    for (size_t i = 0; i < n; ++i) {
+        if (*(int*) csc_cvector_at(v, i) != copy[i]) {
+            fputs("sort results differ from qsort!\n", stderr);
+            exit(1);
+        }
+    }
+    csc_cvector_destroy(v);
+
+    free(copy);
+    free(input);
+}
+
+static int _cmp_int_ptr(const void* a, const void* b)
+{
+    return csc_cmp_int(*(void* const*)a, *(void* const*)b);
+}
+
+static void _bench_sort_pointers(size_t n)
+{
+    int* input = malloc(n * sizeof(int));
+    void** ptrs = malloc(n * sizeof(void*));
+    if (input == NULL || ptrs == NULL) {
+        fputs("couldn't allocate benchmark input\n", stderr);
+        exit(1);
+    }
+    _fill_random(input, n);
+    for (size_t i = 0; i < n; ++i) {
+        ptrs[i] = &input[i];
+    }
+
+    // baseline: libc qsort over an array of pointers.
+    cvector* v = csc_cvector_create_from(ptrs, n);
+    double start = _now();
+    qsort(ptrs, n, sizeof(void*), _cmp_int_ptr);
+    _report("qsort (pointers)", n, _now() - start);
+
+    // introsort on pointer storage.
+    start = _now();
+    csc_cvector_sort(v, csc_cmp_int);
+    _report("csc_cvector_sort (pointers)", n, _now() - start);
+    csc_cvector_destroy(v);
+
+    free(ptrs);
+    free(input);
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = 1000000;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (n == 0) {
+        fputs("the number of elements must be greater than 0\n", stderr);
+        return 1;
+    }
+
+    _bench_sort(n);
+    _bench_sort_pointers(n);
+
+    return 0;
+}
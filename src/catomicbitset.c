@@ -0,0 +1,216 @@
+/**
+ * @file catomicbitset.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #catomicbitset data structure.
+ *
+ * @see catomicbitset.h
+ *
+ */
+
+#include "catomicbitset.h"
+#include <assert.h>
+#include <string.h>
+
+#ifdef CSC_64
+    typedef uint64_t atomic_word;
+#else
+    typedef uint32_t atomic_word;
+#endif
+
+#define CSC_BITSIZE ((sizeof(atomic_word)) * (8))
+
+// The library is C99, so the words are accessed through compiler intrinsics rather than C11 _Atomic.
+// Read-modify-writes are acquire-release so releasing a bit publishes the writes made while it was held.
+#if defined(__GNUC__) || defined(__clang__)
+    #define _load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define _fetch_or(p, mask) __atomic_fetch_or((p), (mask), __ATOMIC_ACQ_REL)
+    #define _fetch_and(p, mask) __atomic_fetch_and((p), (mask), __ATOMIC_ACQ_REL)
+#elif defined(_MSC_VER)
+    #include <intrin.h>
+    #ifdef CSC_64
+        #define _load(p) ((atomic_word)_InterlockedOr64((volatile __int64*)(p), 0))
+        #define _fetch_or(p, mask) ((atomic_word)_InterlockedOr64((volatile __int64*)(p), (__int64)(mask)))
+        #define _fetch_and(p, mask) ((atomic_word)_InterlockedAnd64((volatile __int64*)(p), (__int64)(mask)))
+    #else
+        #define _load(p) ((atomic_word)_InterlockedOr((volatile long*)(p), 0))
+        #define _fetch_or(p, mask) ((atomic_word)_InterlockedOr((volatile long*)(p), (long)(mask)))
+        #define _fetch_and(p, mask) ((atomic_word)_InterlockedAnd((volatile long*)(p), (long)(mask)))
+    #endif
+#else
+    #error "Atomic operations are not supported by this compiler."
+#endif
+
+struct catomicbitset {
+    atomic_word* data; /**< The internal data of the bitset. */
+    size_t nbits;      /**< The number of bits the bitset can hold. */
+    size_t size;       /**< The number of elements stored in @c catomicbitset#data. */
+    csc_allocator allocator; /**< The allocator used for the bitset. */
+};
+
+// returns the size of the single block holding the bitset and its data.
+static size_t _block_size(size_t n_elems)
+{
+    return (n_elems * sizeof(atomic_word)) + sizeof(catomicbitset);
+}
+
+// returns the mask of the bits of word idx that are inside the bitset.
+static atomic_word _valid_mask(const catomicbitset* b, size_t idx)
+{
+    const size_t tail = b->nbits % CSC_BITSIZE;
+    if (idx == b->size - 1 && tail != 0) {
+        return ((atomic_word)1 << tail) - 1;
+    }
+    return ~(atomic_word)0;
+}
+
+// claims a clear bit of word idx among the bits in mask. Returns the bit within the word or CSC_BITSIZE if none.
+static size_t _claim_in_word(atomic_word* word, atomic_word mask)
+{
+    atomic_word free_bits = ~_load(word) & mask;
+    while (free_bits != 0) {
+        const atomic_word bit = (atomic_word)1 << csc_ctz64(free_bits);
+        const atomic_word old = _fetch_or(word, bit);
+        if ((old & bit) == 0) {
+            return csc_ctz64(bit);
+        }
+
+        // another thread got there first. retry with what the word looks like now.
+        free_bits = ~old & mask;
+    }
+    return CSC_BITSIZE;
+}
+
+catomicbitset* csc_catomicbitset_create(size_t nbits)
+{
+    return csc_catomicbitset_create_with_allocator(nbits, csc_default_allocator());
+}
+
+catomicbitset* csc_catomicbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+
+    // zero sized bitset is not allowed.
+    if (nbits == 0) {
+        return NULL;
+    }
+
+    const size_t n_elems = (nbits / CSC_BITSIZE) + ((nbits % CSC_BITSIZE) != 0 ? 1 : 0);
+    char* data = allocator->alloc(_block_size(n_elems), allocator->context);
+    if (data == NULL) {
+        return NULL;
+    }
+    memset(data, 0, _block_size(n_elems));
+
+    catomicbitset* b = (catomicbitset*)data;
+    b->data = (atomic_word*)(data + sizeof(catomicbitset));
+    b->nbits = nbits;
+    b->size = n_elems;
+    b->allocator = *allocator;
+
+    return b;
+}
+
+void csc_catomicbitset_destroy(catomicbitset* b)
+{
+    assert(b != NULL);
+    const csc_allocator a = b->allocator;
+    a.free(b, _block_size(b->size), a.context);
+}
+
+size_t csc_catomicbitset_size(const catomicbitset* b)
+{
+    assert(b != NULL);
+    return b->nbits;
+}
+
+bool csc_catomicbitset_at(const catomicbitset* b, size_t bit, CSCError* e)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return false;
+    }
+
+    const atomic_word elem = _load(&(b->data[bit / CSC_BITSIZE]));
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return (elem & ((atomic_word)1 << (bit % CSC_BITSIZE))) != 0;
+}
+
+bool csc_catomicbitset_test_and_set(catomicbitset* b, size_t bit, CSCError* e)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return false;
+    }
+
+    const atomic_word mask = (atomic_word)1 << (bit % CSC_BITSIZE);
+    const atomic_word old = _fetch_or(&(b->data[bit / CSC_BITSIZE]), mask);
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return (old & mask) != 0;
+}
+
+bool csc_catomicbitset_test_and_clear(catomicbitset* b, size_t bit, CSCError* e)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return false;
+    }
+
+    const atomic_word mask = (atomic_word)1 << (bit % CSC_BITSIZE);
+    const atomic_word old = _fetch_and(&(b->data[bit / CSC_BITSIZE]), ~mask);
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return (old & mask) != 0;
+}
+
+size_t csc_catomicbitset_claim(catomicbitset* b, size_t hint)
+{
+    assert(b != NULL);
+    if (hint >= b->nbits) {
+        hint = 0;
+    }
+
+    // the word holding the hint is visited twice: first for the bits at or after the hint
+    // and, after wrapping around, for the bits before it.
+    const size_t first = hint / CSC_BITSIZE;
+    const atomic_word after_hint = ~(atomic_word)0 << (hint % CSC_BITSIZE);
+    for (size_t i = 0; i <= b->size; ++i) {
+        const size_t idx = (first + i) % b->size;
+        atomic_word mask = _valid_mask(b, idx);
+        if (i == 0) {
+            mask &= after_hint;
+        } else if (i == b->size) {
+            mask &= ~after_hint;
+        }
+
+        const size_t bit = _claim_in_word(&(b->data[idx]), mask);
+        if (bit != CSC_BITSIZE) {
+            return (idx * CSC_BITSIZE) + bit;
+        }
+    }
+    return b->nbits;
+}
+
+size_t csc_catomicbitset_count(const catomicbitset* b)
+{
+    assert(b != NULL);
+    size_t count = 0;
+    for (size_t i = 0; i < b->size; ++i) {
+        count += csc_popcount64(_load(&(b->data[i])));
+    }
+    return count;
+}
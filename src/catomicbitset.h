@@ -0,0 +1,196 @@
+#pragma once
+
+/**
+ * @file catomicbitset.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #catomicbitset data structure.
+ *
+ * A #catomicbitset is a fixed size bitset whose bits may be read and modified by several threads at once without
+ * any external locking. Every modification is a single atomic read-modify-write of the word holding the bit, so
+ * threads working on different bits of the same word never lose each other's updates.
+ *
+ * The typical use is a slot allocator shared by worker threads:
+ *
+ * @code
+ * // track 1024 slots
+ * catomicbitset* slots = csc_catomicbitset_create(1024);
+ *
+ * //
+ * // on any thread...
+ * //
+ *
+ * // claim a free slot, starting the search near a per-thread hint to reduce contention
+ * size_t slot = csc_catomicbitset_claim(slots, hint);
+ * if (slot == csc_catomicbitset_size(slots)) {
+ *      // every slot is taken
+ * }
+ *
+ * // ... use the slot ...
+ *
+ * // give the slot back
+ * csc_catomicbitset_test_and_clear(slots, slot, NULL);
+ *
+ * //
+ * // once every thread is done...
+ * //
+ *
+ * csc_catomicbitset_destroy(slots);
+ * @endcode
+ *
+ * Creating and destroying the bitset is not thread safe. A set bit that is cleared by one thread and claimed by
+ * another synchronizes the two threads, so data written to a slot before releasing it is visible to the next owner.
+ *
+ * @see cbitset.h
+ *
+ */
+
+#include "csc.h"
+
+/**
+ * @brief the catomicbitset data structure.
+ *
+ * Unlike #cbitset, the size of the bitset is fixed at creation.
+ *
+ */
+typedef struct catomicbitset catomicbitset;
+
+/**
+ * @brief creates a #catomicbitset.
+ *
+ * This function creates a #catomicbitset capable of holding @p nbits of data. Note that @p nbits must be greater
+ * than 0. The bitset is initialized with all of the bits cleared.
+ *
+ * @param nbits the number of bits the bitset should manage.
+ *
+ * @return a pointer to a #catomicbitset if successful. On failure or if @p nbits is 0, @c NULL is returned.
+ *
+ * @see csc_catomicbitset_destroy
+ *
+ */
+catomicbitset* csc_catomicbitset_create(size_t nbits);
+
+/**
+ * @brief creates a #catomicbitset using a custom allocator.
+ *
+ * This function is identical to #csc_catomicbitset_create except that the bitset is allocated through
+ * @p allocator.
+ *
+ * @param nbits the number of bits the bitset should manage.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a #catomicbitset if successful. On failure or if @p nbits is 0, @c NULL is returned.
+ *
+ * @see csc_catomicbitset_destroy
+ *
+ */
+catomicbitset* csc_catomicbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator);
+
+/**
+ * @brief destroys a #catomicbitset.
+ *
+ * No other thread may be using the bitset.
+ *
+ * @param b the bitset to destroy. Must be @b non-null.
+ *
+ */
+void csc_catomicbitset_destroy(catomicbitset* b);
+
+/**
+ * @brief returns the number of bits the bitset holds.
+ *
+ * @param b the bitset. Must be @b non-null.
+ *
+ * @return the number of bits.
+ */
+size_t csc_catomicbitset_size(const catomicbitset* b);
+
+/**
+ * @brief atomically retrieves the state of the bit at the specified 0-indexed position.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to check.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ *
+ * @return On success, @p e is @c CSCError#E_NOERR. If @p bit is out of range, @p e is @c CSCError#E_OUTOFRANGE.
+ * If the bit is set, @c true is returned and @c false otherwise.
+ *
+ */
+bool csc_catomicbitset_at(const catomicbitset* b, size_t bit, CSCError* e);
+
+/**
+ * @brief atomically sets the bit at the specified 0-indexed position and returns its previous state.
+ *
+ * Exactly one of several threads setting the same clear bit sees @c false returned, which makes this a try-lock
+ * on the bit.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to set.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ *
+ * @return On success, @p e is @c CSCError#E_NOERR. If @p bit is out of range, @p e is @c CSCError#E_OUTOFRANGE.
+ * If the bit was already set, @c true is returned and @c false otherwise.
+ *
+ */
+bool csc_catomicbitset_test_and_set(catomicbitset* b, size_t bit, CSCError* e);
+
+/**
+ * @brief atomically clears the bit at the specified 0-indexed position and returns its previous state.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to clear.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ *
+ * @return On success, @p e is @c CSCError#E_NOERR. If @p bit is out of range, @p e is @c CSCError#E_OUTOFRANGE.
+ * If the bit was set, @c true is returned and @c false otherwise.
+ *
+ */
+bool csc_catomicbitset_test_and_clear(catomicbitset* b, size_t bit, CSCError* e);
+
+/**
+ * @brief finds a clear bit and atomically sets it.
+ *
+ * The search starts at @p hint, wraps around past the end of the bitset and stops after every bit has been
+ * considered once. Whole words are skipped while all their bits are set. No locks are taken: if another thread sets
+ * the chosen bit first, the search moves on to the next clear bit.
+ *
+ * Giving each thread a different @p hint spreads the threads over different words and reduces contention.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(n) in the worst case, proportional to the number of words skipped.
+ *
+ * @param b the bitset.
+ * @param hint the bit to start searching from. Values past the end of the bitset start at bit 0.
+ *
+ * @return the index of the bit claimed by this call or the size of the bitset if no clear bit was found.
+ */
+size_t csc_catomicbitset_claim(catomicbitset* b, size_t hint);
+
+/**
+ * @brief returns the number of set bits in the bitset.
+ *
+ * Each word is read atomically, but the bitset may change while the words are counted, so the result is only exact
+ * if no other thread modifies the bitset concurrently.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(n)
+ *
+ * @param b the bitset.
+ *
+ * @return the number of set bits.
+ */
+size_t csc_catomicbitset_count(const catomicbitset* b);
@@ -0,0 +1,775 @@
+/**
+ * @file cbitmap.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #cbitmap data structure.
+ *
+ * @see cbitmap.h
+ *
+ */
+
+#include "cbitmap.h"
+#include "cvector.h"
+#include <assert.h>
+#include <string.h>
+
+// the number of values covered by a single chunk.
+#define CSC_CHUNK_BITS 65536
+
+// array chunks never hold more values than this. An array of this size takes as much memory as a bitmap chunk.
+#define CSC_ARRAY_MAX 4096
+
+// the representations a chunk can take.
+typedef enum _kind {
+    _ARRAY,
+    _BITMAP,
+    _RUN
+} _kind;
+
+typedef struct _run {
+    uint16_t start; /**< The first value of the run. */
+    uint16_t last; /**< The last value of the run, inclusive. */
+} _run;
+
+typedef struct _chunk {
+    uint32_t card; /**< The number of values in the chunk. Chunks are never empty. */
+    uint32_t n; /**< The number of values or runs in use for array and run chunks. */
+    uint32_t cap; /**< The number of values or runs allocated for array and run chunks. */
+    uint16_t key; /**< The high 16 bits shared by every value of the chunk. */
+    uint8_t kind; /**< The #_kind of the chunk. */
+    union {
+        uint16_t* values; /**< The sorted low 16 bits of an array chunk. */
+        _run* runs; /**< The sorted, non-adjacent runs of a run chunk. */
+        cbitset* bits; /**< The bits of a bitmap chunk. */
+    } u;
+} _chunk;
+
+struct cbitmap {
+    cvector* chunks; /**< The chunks of the bitmap stored inline and sorted by key. */
+    csc_allocator allocator; /**< The allocator used for the bitmap and its chunks. */
+};
+
+static int _cmp_key(const void* a, const void* b)
+{
+    const uint16_t ka = ((const _chunk*)a)->key;
+    const uint16_t kb = ((const _chunk*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+static _chunk* _chunk_at_idx(const cbitmap* b, size_t idx)
+{
+    return csc_cvector_at(b->chunks, idx);
+}
+
+// returns the chunk with the key or NULL. idx is set to the position the chunk has or would have.
+static _chunk* _find_chunk(const cbitmap* b, uint16_t key, size_t* idx)
+{
+    _chunk probe;
+    memset(&probe, 0, sizeof(probe));
+    probe.key = key;
+
+    *idx = csc_cvector_lower_bound(b->chunks, &probe, _cmp_key);
+    _chunk* c = _chunk_at_idx(b, *idx);
+    return (c != NULL && c->key == key) ? c : NULL;
+}
+
+static void _free_chunk(const csc_allocator* a, _chunk* c)
+{
+    switch (c->kind) {
+    case _ARRAY:
+        a->free(c->u.values, c->cap * sizeof(uint16_t), a->context);
+        break;
+    case _RUN:
+        a->free(c->u.runs, c->cap * sizeof(_run), a->context);
+        break;
+    case _BITMAP:
+        csc_cbitset_destroy(c->u.bits);
+        break;
+    }
+    c->u.values = NULL;
+    c->n = 0;
+    c->cap = 0;
+}
+
+// returns the index of the first value that isn't less than x.
+static uint32_t _array_lower_bound(const uint16_t* values, uint32_t n, uint16_t x)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    while (lo < hi) {
+        const uint32_t mid = lo + ((hi - lo) / 2);
+        if (values[mid] < x) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// returns the index of the first run that ends at or after x.
+static uint32_t _run_lower_bound(const _run* runs, uint32_t n, uint16_t x)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    while (lo < hi) {
+        const uint32_t mid = lo + ((hi - lo) / 2);
+        if (runs[mid].last < x) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool _chunk_contains(const _chunk* c, uint16_t x)
+{
+    switch (c->kind) {
+    case _ARRAY: {
+        const uint32_t i = _array_lower_bound(c->u.values, c->n, x);
+        return i < c->n && c->u.values[i] == x;
+    }
+    case _RUN: {
+        const uint32_t i = _run_lower_bound(c->u.runs, c->n, x);
+        return i < c->n && c->u.runs[i].start <= x;
+    }
+    case _BITMAP:
+        return csc_cbitset_at(c->u.bits, x, NULL);
+    }
+    return false;
+}
+
+static CSCError _to_bitmap(const csc_allocator* a, _chunk* c)
+{
+    cbitset* bits = csc_cbitset_create_with_allocator(CSC_CHUNK_BITS, a);
+    if (bits == NULL) {
+        return E_OUTOFMEM;
+    }
+
+    if (c->kind == _ARRAY) {
+        for (uint32_t i = 0; i < c->n; ++i) {
+            csc_cbitset_set(bits, c->u.values[i]);
+        }
+    } else if (c->kind == _RUN) {
+        for (uint32_t i = 0; i < c->n; ++i) {
+            csc_cbitset_set_range(bits, c->u.runs[i].start, (size_t)c->u.runs[i].last + 1);
+        }
+    }
+
+    _free_chunk(a, c);
+    c->kind = _BITMAP;
+    c->u.bits = bits;
+
+    return E_NOERR;
+}
+
+// releases the spare capacity of an array chunk.
+static CSCError _shrink_array(const csc_allocator* a, _chunk* c)
+{
+    uint16_t* values = a->realloc(c->u.values, c->cap * sizeof(uint16_t), c->n * sizeof(uint16_t), a->context);
+    if (values == NULL) {
+        return E_OUTOFMEM;
+    }
+    c->u.values = values;
+    c->cap = c->n;
+
+    return E_NOERR;
+}
+
+// converts a chunk with at most CSC_ARRAY_MAX values to an array.
+static CSCError _to_array(const csc_allocator* a, _chunk* c)
+{
+    assert(c->card <= CSC_ARRAY_MAX);
+    uint16_t* values = a->alloc(c->card * sizeof(uint16_t), a->context);
+    if (values == NULL) {
+        return E_OUTOFMEM;
+    }
+
+    uint32_t n = 0;
+    if (c->kind == _BITMAP) {
+        for (csc_cbitset_iter it = csc_cbitset_iter_begin(c->u.bits); csc_cbitset_iter_valid(&it);
+             csc_cbitset_iter_next(&it)) {
+            values[n++] = (uint16_t)csc_cbitset_iter_get(&it);
+        }
+    } else if (c->kind == _RUN) {
+        for (uint32_t i = 0; i < c->n; ++i) {
+            for (uint32_t x = c->u.runs[i].start; x <= c->u.runs[i].last; ++x) {
+                values[n++] = (uint16_t)x;
+            }
+        }
+    }
+
+    _free_chunk(a, c);
+    c->kind = _ARRAY;
+    c->u.values = values;
+    c->n = n;
+    c->cap = n;
+
+    return E_NOERR;
+}
+
+// returns the number of runs of consecutive values in the chunk.
+static uint32_t _count_runs(const _chunk* c)
+{
+    uint32_t runs = 0;
+    switch (c->kind) {
+    case _ARRAY:
+        for (uint32_t i = 0; i < c->n; ++i) {
+            if (i == 0 || c->u.values[i] != c->u.values[i - 1] + 1) {
+                ++runs;
+            }
+        }
+        break;
+    case _RUN:
+        runs = c->n;
+        break;
+    case _BITMAP: {
+        // a run starts at every set bit whose lower neighbour is clear.
+        const size_t nwords = csc_cbitset_word_count(c->u.bits);
+        cbitset_word carry = 0;
+        for (size_t i = 0; i < nwords; ++i) {
+            const cbitset_word w = csc_cbitset_get_word(c->u.bits, i, NULL);
+            runs += csc_popcount64(w & ~((w << 1) | carry));
+            carry = w >> ((8 * sizeof(cbitset_word)) - 1);
+        }
+        break;
+    }
+    }
+    return runs;
+}
+
+// appends x to the runs being built, extending the last run if x follows it.
+static void _append_run(_run* runs, uint32_t* n, uint16_t x)
+{
+    if (*n > 0 && (uint32_t)runs[*n - 1].last + 1 == x) {
+        runs[*n - 1].last = x;
+    } else {
+        runs[*n].start = x;
+        runs[*n].last = x;
+        ++*n;
+    }
+}
+
+static CSCError _to_runs(const csc_allocator* a, _chunk* c, uint32_t nruns)
+{
+    _run* runs = a->alloc(nruns * sizeof(_run), a->context);
+    if (runs == NULL) {
+        return E_OUTOFMEM;
+    }
+
+    uint32_t n = 0;
+    if (c->kind == _ARRAY) {
+        for (uint32_t i = 0; i < c->n; ++i) {
+            _append_run(runs, &n, c->u.values[i]);
+        }
+    } else {
+        for (csc_cbitset_iter it = csc_cbitset_iter_begin(c->u.bits); csc_cbitset_iter_valid(&it);
+             csc_cbitset_iter_next(&it)) {
+            _append_run(runs, &n, (uint16_t)csc_cbitset_iter_get(&it));
+        }
+    }
+
+    _free_chunk(a, c);
+    c->kind = _RUN;
+    c->u.runs = runs;
+    c->n = n;
+    c->cap = n;
+
+    return E_NOERR;
+}
+
+// converts a run chunk to the representation it would have had without runs so it can be modified.
+static CSCError _expand_runs(const csc_allocator* a, _chunk* c)
+{
+    if (c->kind != _RUN) {
+        return E_NOERR;
+    }
+    return c->card <= CSC_ARRAY_MAX ? _to_array(a, c) : _to_bitmap(a, c);
+}
+
+// converts a bitmap chunk that became sparse back to an array. Failing to do so only costs memory.
+static void _shrink_bitmap(const csc_allocator* a, _chunk* c)
+{
+    if (c->kind == _BITMAP && c->card <= CSC_ARRAY_MAX && c->card != 0) {
+        _to_array(a, c);
+    }
+}
+
+static CSCError _chunk_set(const csc_allocator* a, _chunk* c, uint16_t x)
+{
+    CSCError e = _expand_runs(a, c);
+    if (e != E_NOERR) {
+        return e;
+    }
+
+    if (c->kind == _BITMAP) {
+        if (!csc_cbitset_at(c->u.bits, x, NULL)) {
+            csc_cbitset_set(c->u.bits, x);
+            ++c->card;
+        }
+        return E_NOERR;
+    }
+
+    const uint32_t i = _array_lower_bound(c->u.values, c->n, x);
+    if (i < c->n && c->u.values[i] == x) {
+        return E_NOERR;
+    }
+
+    if (c->n == CSC_ARRAY_MAX) {
+        e = _to_bitmap(a, c);
+        if (e != E_NOERR) {
+            return e;
+        }
+        return _chunk_set(a, c, x);
+    }
+
+    if (c->n == c->cap) {
+        uint32_t cap = c->cap == 0 ? 4 : c->cap * 2;
+        if (cap > CSC_ARRAY_MAX) {
+            cap = CSC_ARRAY_MAX;
+        }
+        uint16_t* values = c->u.values == NULL
+            ? a->alloc(cap * sizeof(uint16_t), a->context)
+            : a->realloc(c->u.values, c->cap * sizeof(uint16_t), cap * sizeof(uint16_t), a->context);
+        if (values == NULL) {
+            return E_OUTOFMEM;
+        }
+        c->u.values = values;
+        c->cap = cap;
+    }
+
+    memmove(&(c->u.values[i + 1]), &(c->u.values[i]), (c->n - i) * sizeof(uint16_t));
+    c->u.values[i] = x;
+    ++c->n;
+    ++c->card;
+
+    return E_NOERR;
+}
+
+static CSCError _chunk_clear(const csc_allocator* a, _chunk* c, uint16_t x)
+{
+    if (!_chunk_contains(c, x)) {
+        return E_NOERR;
+    }
+
+    CSCError e = _expand_runs(a, c);
+    if (e != E_NOERR) {
+        return e;
+    }
+
+    if (c->kind == _BITMAP) {
+        csc_cbitset_clear(c->u.bits, x);
+        --c->card;
+        _shrink_bitmap(a, c);
+        return E_NOERR;
+    }
+
+    const uint32_t i = _array_lower_bound(c->u.values, c->n, x);
+    memmove(&(c->u.values[i]), &(c->u.values[i + 1]), (c->n - i - 1) * sizeof(uint16_t));
+    --c->n;
+    --c->card;
+
+    return E_NOERR;
+}
+
+static CSCError _chunk_clone(const csc_allocator* a, _chunk* dst, const _chunk* src)
+{
+    *dst = *src;
+    switch (src->kind) {
+    case _ARRAY:
+        dst->u.values = a->alloc(src->n * sizeof(uint16_t), a->context);
+        if (dst->u.values == NULL) {
+            return E_OUTOFMEM;
+        }
+        memcpy(dst->u.values, src->u.values, src->n * sizeof(uint16_t));
+        dst->cap = src->n;
+        break;
+    case _RUN:
+        dst->u.runs = a->alloc(src->n * sizeof(_run), a->context);
+        if (dst->u.runs == NULL) {
+            return E_OUTOFMEM;
+        }
+        memcpy(dst->u.runs, src->u.runs, src->n * sizeof(_run));
+        dst->cap = src->n;
+        break;
+    case _BITMAP:
+        dst->u.bits = csc_cbitset_create_with_allocator(CSC_CHUNK_BITS, a);
+        if (dst->u.bits == NULL) {
+            return E_OUTOFMEM;
+        }
+        csc_cbitset_or(dst->u.bits, src->u.bits);
+        break;
+    }
+    return E_NOERR;
+}
+
+static CSCError _chunk_or(const csc_allocator* a, _chunk* c, const _chunk* s)
+{
+    CSCError e = _expand_runs(a, c);
+    if (e != E_NOERR) {
+        return e;
+    }
+
+    if (c->kind == _ARRAY && s->kind == _ARRAY && c->n + s->n <= CSC_ARRAY_MAX) {
+        // merge the two sorted arrays.
+        uint16_t* values = a->alloc((c->n + s->n) * sizeof(uint16_t), a->context);
+        if (values == NULL) {
+            return E_OUTOFMEM;
+        }
+
+        uint32_t i = 0;
+        uint32_t j = 0;
+        uint32_t n = 0;
+        while (i < c->n || j < s->n) {
+            if (j == s->n || (i < c->n && c->u.values[i] < s->u.values[j])) {
+                values[n++] = c->u.values[i++];
+            } else if (i == c->n || s->u.values[j] < c->u.values[i]) {
+                values[n++] = s->u.values[j++];
+            } else {
+                values[n++] = c->u.values[i++];
+                ++j;
+            }
+        }
+
+        _free_chunk(a, c);
+        c->u.values = values;
+        c->n = n;
+        c->cap = n;
+        c->card = n;
+        return E_NOERR;
+    }
+
+    if (c->kind == _ARRAY) {
+        e = _to_bitmap(a, c);
+        if (e != E_NOERR) {
+            return e;
+        }
+    }
+
+    switch (s->kind) {
+    case _ARRAY:
+        for (uint32_t i = 0; i < s->n; ++i) {
+            csc_cbitset_set(c->u.bits, s->u.values[i]);
+        }
+        break;
+    case _RUN:
+        for (uint32_t i = 0; i < s->n; ++i) {
+            csc_cbitset_set_range(c->u.bits, s->u.runs[i].start, (size_t)s->u.runs[i].last + 1);
+        }
+        break;
+    case _BITMAP:
+        csc_cbitset_or(c->u.bits, s->u.bits);
+        break;
+    }
+    c->card = (uint32_t)csc_cbitset_count(c->u.bits);
+
+    return E_NOERR;
+}
+
+static CSCError _chunk_and(const csc_allocator* a, _chunk* c, const _chunk* s)
+{
+    CSCError e = _expand_runs(a, c);
+    if (e != E_NOERR) {
+        return e;
+    }
+
+    if (c->kind == _ARRAY) {
+        // keep the values of the array that s also holds.
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < c->n; ++i) {
+            if (_chunk_contains(s, c->u.values[i])) {
+                c->u.values[n++] = c->u.values[i];
+            }
+        }
+        c->n = n;
+        c->card = n;
+        return E_NOERR;
+    }
+
+    if (s->kind == _BITMAP) {
+        csc_cbitset_and(c->u.bits, s->u.bits);
+    } else {
+        // clear the bits s doesn't hold.
+        for (size_t x = csc_cbitset_find_first(c->u.bits); x < CSC_CHUNK_BITS;
+             x = csc_cbitset_find_next(c->u.bits, x + 1)) {
+            if (!_chunk_contains(s, (uint16_t)x)) {
+                csc_cbitset_clear(c->u.bits, x);
+            }
+        }
+    }
+    c->card = (uint32_t)csc_cbitset_count(c->u.bits);
+    _shrink_bitmap(a, c);
+
+    return E_NOERR;
+}
+
+// returns the number of bytes used by the payload of a chunk.
+static size_t _chunk_memory(const _chunk* c)
+{
+    switch (c->kind) {
+    case _ARRAY:
+        return c->cap * sizeof(uint16_t);
+    case _RUN:
+        return c->cap * sizeof(_run);
+    case _BITMAP:
+        return csc_cbitset_word_count(c->u.bits) * sizeof(cbitset_word);
+    }
+    return 0;
+}
+
+cbitmap* csc_cbitmap_create(void)
+{
+    return csc_cbitmap_create_with_allocator(csc_default_allocator());
+}
+
+cbitmap* csc_cbitmap_create_with_allocator(const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    cvector* chunks = csc_cvector_create_sized_with_allocator(sizeof(_chunk), allocator);
+    if (chunks == NULL) {
+        return NULL;
+    }
+
+    cbitmap* b = allocator->alloc(sizeof(*b), allocator->context);
+    if (b == NULL) {
+        csc_cvector_destroy(chunks);
+        return NULL;
+    }
+    b->chunks = chunks;
+    b->allocator = *allocator;
+
+    return b;
+}
+
+void csc_cbitmap_destroy(cbitmap* b)
+{
+    assert(b != NULL);
+    const csc_allocator a = b->allocator;
+    const size_t n = csc_cvector_size(b->chunks);
+    for (size_t i = 0; i < n; ++i) {
+        _free_chunk(&a, _chunk_at_idx(b, i));
+    }
+    csc_cvector_destroy(b->chunks);
+    a.free(b, sizeof(*b), a.context);
+}
+
+CSCError csc_cbitmap_set(cbitmap* b, uint32_t bit)
+{
+    assert(b != NULL);
+    const uint16_t key = (uint16_t)(bit >> 16);
+    const uint16_t low = (uint16_t)(bit & 0xFFFF);
+
+    size_t idx = 0;
+    _chunk* c = _find_chunk(b, key, &idx);
+    if (c != NULL) {
+        return _chunk_set(&(b->allocator), c, low);
+    }
+
+    _chunk fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.key = key;
+    fresh.kind = _ARRAY;
+    CSCError e = _chunk_set(&(b->allocator), &fresh, low);
+    if (e != E_NOERR) {
+        return e;
+    }
+
+    e = csc_cvector_insert(b->chunks, idx, &fresh);
+    if (e != E_NOERR) {
+        _free_chunk(&(b->allocator), &fresh);
+    }
+    return e;
+}
+
+CSCError csc_cbitmap_clear(cbitmap* b, uint32_t bit)
+{
+    assert(b != NULL);
+    size_t idx = 0;
+    _chunk* c = _find_chunk(b, (uint16_t)(bit >> 16), &idx);
+    if (c == NULL) {
+        return E_NOERR;
+    }
+
+    CSCError e = _chunk_clear(&(b->allocator), c, (uint16_t)(bit & 0xFFFF));
+    if (e == E_NOERR && c->card == 0) {
+        _free_chunk(&(b->allocator), c);
+        csc_cvector_rm_at_ordered(b->chunks, idx);
+    }
+    return e;
+}
+
+bool csc_cbitmap_at(const cbitmap* b, uint32_t bit)
+{
+    assert(b != NULL);
+    size_t idx = 0;
+    const _chunk* c = _find_chunk(b, (uint16_t)(bit >> 16), &idx);
+    return c != NULL && _chunk_contains(c, (uint16_t)(bit & 0xFFFF));
+}
+
+uint64_t csc_cbitmap_count(const cbitmap* b)
+{
+    assert(b != NULL);
+    uint64_t count = 0;
+    const size_t n = csc_cvector_size(b->chunks);
+    for (size_t i = 0; i < n; ++i) {
+        count += _chunk_at_idx(b, i)->card;
+    }
+    return count;
+}
+
+bool csc_cbitmap_empty(const cbitmap* b)
+{
+    assert(b != NULL);
+    return csc_cvector_empty(b->chunks);
+}
+
+CSCError csc_cbitmap_or(cbitmap* dst, const cbitmap* src)
+{
+    assert(dst != NULL && src != NULL);
+    const csc_allocator* a = &(dst->allocator);
+    const size_t m = csc_cvector_size(src->chunks);
+
+    size_t i = 0;
+    for (size_t j = 0; j < m; ++j, ++i) {
+        const _chunk* s = _chunk_at_idx(src, j);
+        while (i < csc_cvector_size(dst->chunks) && _chunk_at_idx(dst, i)->key < s->key) {
+            ++i;
+        }
+
+        _chunk* c = _chunk_at_idx(dst, i);
+        CSCError e = E_NOERR;
+        if (c != NULL && c->key == s->key) {
+            e = _chunk_or(a, c, s);
+        } else {
+            _chunk copy;
+            e = _chunk_clone(a, &copy, s);
+            if (e == E_NOERR) {
+                e = csc_cvector_insert(dst->chunks, i, &copy);
+                if (e != E_NOERR) {
+                    _free_chunk(a, &copy);
+                }
+            }
+        }
+        if (e != E_NOERR) {
+            return e;
+        }
+    }
+    return E_NOERR;
+}
+
+CSCError csc_cbitmap_and(cbitmap* dst, const cbitmap* src)
+{
+    assert(dst != NULL && src != NULL);
+    const csc_allocator* a = &(dst->allocator);
+    const size_t n = csc_cvector_size(dst->chunks);
+    const size_t m = csc_cvector_size(src->chunks);
+
+    // intersect the chunks in place and compact the non-empty ones towards the front.
+    CSCError e = E_NOERR;
+    size_t kept = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        _chunk* c = _chunk_at_idx(dst, i);
+        if (e == E_NOERR) {
+            while (j < m && _chunk_at_idx(src, j)->key < c->key) {
+                ++j;
+            }
+            if (j < m && _chunk_at_idx(src, j)->key == c->key) {
+                e = _chunk_and(a, c, _chunk_at_idx(src, j));
+            } else {
+                c->card = 0;
+            }
+        }
+
+        if (c->card == 0) {
+            _free_chunk(a, c);
+        } else {
+            if (kept != i) {
+                memcpy(_chunk_at_idx(dst, kept), c, sizeof(*c));
+            }
+            ++kept;
+        }
+    }
+    csc_cvector_rm_range(dst->chunks, kept, n);
+
+    return e;
+}
+
+CSCError csc_cbitmap_optimize(cbitmap* b)
+{
+    assert(b != NULL);
+    const csc_allocator* a = &(b->allocator);
+    const size_t n = csc_cvector_size(b->chunks);
+
+    CSCError result = E_NOERR;
+    for (size_t i = 0; i < n; ++i) {
+        _chunk* c = _chunk_at_idx(b, i);
+
+        // pick the representation taking the fewest bytes.
+        const uint32_t nruns = _count_runs(c);
+        const size_t run_bytes = nruns * sizeof(_run);
+        const size_t array_bytes = c->card <= CSC_ARRAY_MAX ? c->card * sizeof(uint16_t) : SIZE_MAX;
+        const size_t bitmap_bytes = CSC_CHUNK_BITS / 8;
+
+        CSCError e = E_NOERR;
+        if (run_bytes < array_bytes && run_bytes < bitmap_bytes) {
+            if (c->kind != _RUN) {
+                e = _to_runs(a, c, nruns);
+            }
+        } else if (array_bytes <= bitmap_bytes) {
+            if (c->kind != _ARRAY) {
+                e = _to_array(a, c);
+            } else if (c->cap != c->n) {
+                e = _shrink_array(a, c);
+            }
+        } else if (c->kind != _BITMAP) {
+            e = _to_bitmap(a, c);
+        }
+        if (e != E_NOERR) {
+            result = e;
+        }
+    }
+    return result;
+}
+
+size_t csc_cbitmap_memory(const cbitmap* b)
+{
+    assert(b != NULL);
+    const size_t n = csc_cvector_size(b->chunks);
+    size_t bytes = sizeof(*b) + (csc_cvector_capacity(b->chunks) * sizeof(_chunk));
+    for (size_t i = 0; i < n; ++i) {
+        bytes += _chunk_memory(_chunk_at_idx(b, i));
+    }
+    return bytes;
+}
+
+void csc_cbitmap_foreach(const cbitmap* b, csc_bit_foreach fn, void* context)
+{
+    assert(b != NULL);
+    const size_t n = csc_cvector_size(b->chunks);
+    for (size_t i = 0; i < n; ++i) {
+        const _chunk* c = _chunk_at_idx(b, i);
+        const size_t base = (size_t)c->key << 16;
+        switch (c->kind) {
+        case _ARRAY:
+            for (uint32_t k = 0; k < c->n; ++k) {
+                fn(base + c->u.values[k], context);
+            }
+            break;
+        case _RUN:
+            for (uint32_t k = 0; k < c->n; ++k) {
+                for (size_t x = c->u.runs[k].start; x <= c->u.runs[k].last; ++x) {
+                    fn(base + x, context);
+                }
+            }
+            break;
+        case _BITMAP:
+            for (csc_cbitset_iter it = csc_cbitset_iter_begin(c->u.bits); csc_cbitset_iter_valid(&it);
+                 csc_cbitset_iter_next(&it)) {
+                fn(base + csc_cbitset_iter_get(&it), context);
+            }
+            break;
+        }
+    }
+}
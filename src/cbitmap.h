@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * @file cbitmap.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #cbitmap data structure.
+ *
+ * #cbitmap implements a compressed bitmap over the 32 bit integers in the style of Roaring bitmaps. A #cbitset
+ * covering the same range would always cost 512MB. Instead, #cbitmap partitions the range into chunks of 65536 bits
+ * that share their high 16 bits and only stores the chunks that hold at least one set bit. Each chunk picks the
+ * smallest of three representations:
+ *
+ * - an @b array of the sorted low 16 bits of its values, for chunks with at most 4096 values.
+ * - a @b bitmap of 65536 bits, stored in a #cbitset, for dense chunks.
+ * - a list of @b runs of consecutive values, for chunks made of long runs.
+ *
+ * Chunks switch between arrays and bitmaps automatically as values are set and cleared. Runs are only chosen by
+ * #csc_cbitmap_optimize, which is best called once a bitmap has been built.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * cbitmap* b = csc_cbitmap_create();
+ * if (b == NULL) {
+ *      // couldn't create the bitmap
+ * }
+ *
+ * // set some bits anywhere in the 32 bit range
+ * CSCError e = csc_cbitmap_set(b, 7);
+ * if (e != E_NOERR) {
+ *      // handle the error
+ * }
+ * csc_cbitmap_set(b, 4000000000u);
+ *
+ * if (csc_cbitmap_at(b, 4000000000u)) {
+ *      // the bit is set
+ * }
+ *
+ * // pick the smallest representation for every chunk
+ * csc_cbitmap_optimize(b);
+ *
+ * // clean up
+ * csc_cbitmap_destroy(b);
+ * @endcode
+ *
+ * @see cbitset.h
+ */
+
+#include "cbitset.h"
+
+/**
+ * @brief implementation of a compressed bitmap over 32 bit integers.
+ *
+ * @see csc_cbitmap_create
+ */
+typedef struct cbitmap cbitmap;
+
+/**
+ * @brief cbitmap "constructor" function
+ *
+ * This function creates an empty bitmap. No memory is used for chunks until a bit is set.
+ *
+ * @return a pointer to a constructed #cbitmap or @c NULL on failure.
+ *
+ * @see csc_cbitmap_destroy
+ */
+cbitmap* csc_cbitmap_create(void);
+
+/**
+ * @brief cbitmap "constructor" function using a custom allocator.
+ *
+ * This function is identical to #csc_cbitmap_create except that the bitmap and its chunks are allocated through
+ * @p allocator.
+ *
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a constructed #cbitmap or @c NULL on failure.
+ *
+ * @see csc_cbitmap_destroy
+ */
+cbitmap* csc_cbitmap_create_with_allocator(const csc_allocator* allocator);
+
+/**
+ * @brief cbitmap "destructor" function
+ *
+ * This function must be called whenever a cbitmap is no longer used.
+ *
+ * @see csc_cbitmap_create
+ */
+void csc_cbitmap_destroy(cbitmap* b);
+
+/**
+ * @brief sets a bit in the bitmap.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(c)) to find the chunk, where @c c is the number of chunks, plus up to
+ * @c O(4096) to insert into an array chunk.
+ *
+ * @param b the bitmap.
+ * @param bit the bit to set.
+ *
+ * @return On success @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM and the bitmap is
+ * left unchanged.
+ */
+CSCError csc_cbitmap_set(cbitmap* b, uint32_t bit);
+
+/**
+ * @brief clears a bit in the bitmap.
+ *
+ * Chunks left without any set bit are released.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(c)) to find the chunk, where @c c is the number of chunks, plus up to
+ * @c O(4096) to remove from an array chunk.
+ *
+ * @param b the bitmap.
+ * @param bit the bit to clear.
+ *
+ * @return On success @c CSCError#E_NOERR. A run chunk is converted to an array or bitmap before it is modified so
+ * on memory allocation failure @c CSCError#E_OUTOFMEM and the bitmap is left unchanged.
+ */
+CSCError csc_cbitmap_clear(cbitmap* b, uint32_t bit);
+
+/**
+ * @brief checks if a bit is set.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(c)) where @c c is the number of chunks.
+ *
+ * @param b the bitmap.
+ * @param bit the bit to check.
+ *
+ * @return @c true if the bit is set. Otherwise, @c false.
+ */
+bool csc_cbitmap_at(const cbitmap* b, uint32_t bit);
+
+/**
+ * @brief returns the number of set bits in the bitmap.
+ *
+ * Every chunk tracks its own number of set bits so nothing is scanned.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(c) where @c c is the number of chunks.
+ *
+ * @param b the bitmap.
+ *
+ * @return the number of set bits.
+ */
+uint64_t csc_cbitmap_count(const cbitmap* b);
+
+/**
+ * @brief checks if no bit is set.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitmap.
+ *
+ * @return @c true if no bit is set. Otherwise, @c false.
+ */
+bool csc_cbitmap_empty(const cbitmap* b);
+
+/**
+ * @brief replaces @p dst with the union of @p dst and @p src.
+ *
+ * Chunks of @p src missing from @p dst are copied. Matching chunks are combined according to their
+ * representations, e.g. two bitmap chunks are combined with #csc_cbitset_or.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(n + m) where @c n and @c m are the sizes of the two bitmaps' chunks.
+ *
+ * @param dst the bitmap to update.
+ * @param src the other operand.
+ *
+ * @return On success @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM and @p dst holds a
+ * valid bitmap with some but possibly not all of the bits of @p src.
+ */
+CSCError csc_cbitmap_or(cbitmap* dst, const cbitmap* src);
+
+/**
+ * @brief replaces @p dst with the intersection of @p dst and @p src.
+ *
+ * Chunks of @p dst missing from @p src are released. Matching chunks are combined according to their
+ * representations, e.g. two bitmap chunks are combined with #csc_cbitset_and.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(n + m) where @c n and @c m are the sizes of the two bitmaps' chunks.
+ *
+ * @param dst the bitmap to update.
+ * @param src the other operand.
+ *
+ * @return On success @c CSCError#E_NOERR. A run chunk of @p dst is converted before it is modified so on memory
+ * allocation failure @c CSCError#E_OUTOFMEM and @p dst holds a valid bitmap with some of its chunks not yet
+ * intersected.
+ */
+CSCError csc_cbitmap_and(cbitmap* dst, const cbitmap* src);
+
+/**
+ * @brief converts every chunk to its smallest representation.
+ *
+ * Chunks made of long runs of consecutive values become run chunks and arrays release their spare capacity. Call
+ * this after building a bitmap to reduce its memory usage.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(n) where @c n is the size of the bitmap's chunks.
+ *
+ * @param b the bitmap.
+ *
+ * @return On success @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM and the chunks that
+ * couldn't be converted keep their previous representation.
+ */
+CSCError csc_cbitmap_optimize(cbitmap* b);
+
+/**
+ * @brief returns the approximate number of bytes used by the bitmap.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(c) where @c c is the number of chunks.
+ *
+ * @param b the bitmap.
+ *
+ * @return the number of bytes used by the bitmap and its chunks.
+ */
+size_t csc_cbitmap_memory(const cbitmap* b);
+
+/**
+ * @brief applies the callback function to each set bit in ascending order.
+ *
+ * The bitmap must not be modified by the callback.
+ *
+ * <b>Time Complexity:</b> @c O(n) where @c n is the number of set bits plus the size of the bitmap chunks.
+ *
+ * @param b the bitmap. Must be @b non-null.
+ * @param fn the callback function. Must be @b non-null.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ */
+void csc_cbitmap_foreach(const cbitmap* b, csc_bit_foreach fn, void* context);
@@ -8,51 +8,428 @@
  * 
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "cbitset.h"
 #include <assert.h>
 #include <string.h>
 
-#ifdef CSC_64
-    typedef uint_fast64_t bitset_type;
-#else
-    typedef uint_fast32_t bitset_type;
+#ifndef _WIN32
+    #define CSC_POSIX_IO
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+#ifdef CSC_X86_SIMD
+    #include <immintrin.h>
 #endif
 
+typedef cbitset_word bitset_type;
+
 #define CSC_BITSIZE ((sizeof(bitset_type)) * (8))
 
+// the number of words summarized by a single entry of the rank index.
+#define CSC_SUPERBLOCK_WORDS 8
+
+// the operations applied to a range of bits.
+typedef enum _range_op {
+    _RANGE_SET,
+    _RANGE_CLEAR,
+    _RANGE_FLIP
+} _range_op;
+
+// the operations combining two bitsets word by word.
+typedef enum _set_op {
+    _OP_AND,
+    _OP_OR,
+    _OP_XOR,
+    _OP_ANDNOT
+} _set_op;
+
 struct cbitset {
     bitset_type* data; /**< The internal data of the bitset. */
     size_t nbits;      /**< The number of bits the bitset can hold. */
     size_t size;       /**< The number of elements stored in @c cbitset#data. */
+    size_t capacity;   /**< The number of elements allocated after the bitset. */
+    csc_allocator allocator; /**< The allocator used for the bitset. */
+    size_t* index; /**< The number of set bits before each superblock, followed by the total, or @c NULL. */
+    bool indexed; /**< If @c true, @c cbitset#index is up to date with @c cbitset#data. */
+    bool view; /**< If @c true, @c cbitset#data belongs to a buffer passed to #csc_cbitset_view. */
 };
 
+/**
+ * @brief the header written in front of a serialized #cbitset.
+ *
+ */
+typedef struct _serial_header {
+    char magic[8]; /**< Always #CSC_SERIAL_MAGIC. */
+    uint32_t version; /**< The layout version. Always #CSC_SERIAL_VERSION. */
+    uint32_t word_size; /**< The size of a #cbitset_word in bytes. */
+    uint64_t nbits; /**< The number of bits in the bitset. */
+    uint64_t reserved; /**< Unused. Always 0. Keeps the words 32 byte aligned. */
+} _serial_header;
+
+#define CSC_SERIAL_MAGIC "CSCBIT\0"
+#define CSC_SERIAL_VERSION 1
+
+// returns the size of the single block holding the bitset and its data.
+static size_t _block_size(size_t n_elems)
+{
+    return (n_elems * sizeof(bitset_type)) + sizeof(cbitset);
+}
+
+// returns the number of elements needed to store the number of bits.
+static size_t _elems_for(size_t nbits)
+{
+    return (nbits / CSC_BITSIZE) + ((nbits % CSC_BITSIZE) != 0 ? 1 : 0);
+}
+
+// returns the size of the rank index of a bitset with n_elems elements.
+static size_t _index_size(size_t n_elems)
+{
+    const size_t n_super = (n_elems + CSC_SUPERBLOCK_WORDS - 1) / CSC_SUPERBLOCK_WORDS;
+    return (n_super + 1) * sizeof(size_t);
+}
+
+#ifdef CSC_X86_SIMD
+__attribute__((target("popcnt")))
+static size_t _popcount_popcnt(bitset_type elem)
+{
+    return (size_t)__builtin_popcountll((unsigned long long)elem);
+}
+#endif
+
+// counts the bits of a single word with the popcnt instruction when the CPU has it. Loops over many words should
+// dispatch once through _and_count or _scan_rank instead.
+static size_t _popcount(bitset_type elem)
+{
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("popcnt")) {
+        return _popcount_popcnt(elem);
+    }
+#endif
+    return csc_popcount64(elem);
+}
+
+/*
+ * Word kernels for combining and counting bitsets. Each has a scalar version and, on x86, SSE2 and AVX2 versions
+ * that are selected at runtime. The vector versions return the number of words they processed and leave the
+ * remainder to the scalar version.
+ */
+
+static void _combine_scalar(bitset_type* out, const bitset_type* a, const bitset_type* b, size_t n, _set_op op)
+{
+    switch (op) {
+    case _OP_AND:
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] & b[i];
+        }
+        break;
+    case _OP_OR:
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] | b[i];
+        }
+        break;
+    case _OP_XOR:
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] ^ b[i];
+        }
+        break;
+    case _OP_ANDNOT:
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] & ~b[i];
+        }
+        break;
+    }
+}
+
+static size_t _and_count_scalar(const bitset_type* a, const bitset_type* b, size_t n)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += csc_popcount64(a[i] & b[i]);
+    }
+    return count;
+}
+
+// returns the index of the word holding the k-th set bit of the n words and subtracts the set bits of the words
+// before it from k. Returns n if the words have at most k set bits.
+static size_t _scan_rank_scalar(const bitset_type* w, size_t n, size_t* k)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const size_t count = csc_popcount64(w[i]);
+        if (*k < count) {
+            return i;
+        }
+        *k -= count;
+    }
+    return n;
+}
+
+#ifdef CSC_X86_SIMD
+
+__attribute__((target("sse2")))
+static size_t _combine_sse2(bitset_type* out, const bitset_type* a, const bitset_type* b, size_t n, _set_op op)
+{
+    const size_t nbytes = n * sizeof(bitset_type);
+    char* po = (char*)out;
+    const char* pa = (const char*)a;
+    const char* pb = (const char*)b;
+
+    size_t i = 0;
+    for (; i + 16 <= nbytes; i += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(pa + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(pb + i));
+        __m128i r = x;
+        switch (op) {
+        case _OP_AND:
+            r = _mm_and_si128(x, y);
+            break;
+        case _OP_OR:
+            r = _mm_or_si128(x, y);
+            break;
+        case _OP_XOR:
+            r = _mm_xor_si128(x, y);
+            break;
+        case _OP_ANDNOT:
+            r = _mm_andnot_si128(y, x);
+            break;
+        }
+        _mm_storeu_si128((__m128i*)(po + i), r);
+    }
+    return i / sizeof(bitset_type);
+}
+
+__attribute__((target("avx2")))
+static size_t _combine_avx2(bitset_type* out, const bitset_type* a, const bitset_type* b, size_t n, _set_op op)
+{
+    const size_t nbytes = n * sizeof(bitset_type);
+    char* po = (char*)out;
+    const char* pa = (const char*)a;
+    const char* pb = (const char*)b;
+
+    size_t i = 0;
+    for (; i + 32 <= nbytes; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(pa + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(pb + i));
+        __m256i r = x;
+        switch (op) {
+        case _OP_AND:
+            r = _mm256_and_si256(x, y);
+            break;
+        case _OP_OR:
+            r = _mm256_or_si256(x, y);
+            break;
+        case _OP_XOR:
+            r = _mm256_xor_si256(x, y);
+            break;
+        case _OP_ANDNOT:
+            r = _mm256_andnot_si256(y, x);
+            break;
+        }
+        _mm256_storeu_si256((__m256i*)(po + i), r);
+    }
+    return i / sizeof(bitset_type);
+}
+
+// counts bits with the hardware popcnt instruction rather than the portable fallback.
+__attribute__((target("popcnt")))
+static size_t _and_count_popcnt(const bitset_type* a, const bitset_type* b, size_t n)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += (size_t)__builtin_popcountll((unsigned long long)(a[i] & b[i]));
+    }
+    return count;
+}
+
+__attribute__((target("popcnt")))
+static size_t _scan_rank_popcnt(const bitset_type* w, size_t n, size_t* k)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const size_t count = (size_t)__builtin_popcountll((unsigned long long)w[i]);
+        if (*k < count) {
+            return i;
+        }
+        *k -= count;
+    }
+    return n;
+}
+
+// counts 16 bytes per iteration with the classic bit-slicing popcount and sums the bytes with psadbw.
+__attribute__((target("sse2")))
+static size_t _and_count_sse2(const bitset_type* a, const bitset_type* b, size_t n, size_t* count)
+{
+    const size_t nbytes = n * sizeof(bitset_type);
+    const char* pa = (const char*)a;
+    const char* pb = (const char*)b;
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    __m128i acc = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= nbytes; i += 16) {
+        __m128i x = _mm_and_si128(_mm_loadu_si128((const __m128i*)(pa + i)), _mm_loadu_si128((const __m128i*)(pb + i)));
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi16(x, 1), m1));
+        x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi16(x, 2), m2));
+        x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi16(x, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    *count = (size_t)(lanes[0] + lanes[1]);
+    return i / sizeof(bitset_type);
+}
+
+// counts 32 bytes per iteration using a nibble lookup table and sums the bytes with vpsadbw.
+__attribute__((target("avx2")))
+static size_t _and_count_avx2(const bitset_type* a, const bitset_type* b, size_t n, size_t* count)
+{
+    const size_t nbytes = n * sizeof(bitset_type);
+    const char* pa = (const char*)a;
+    const char* pb = (const char*)b;
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 32 <= nbytes; i += 32) {
+        const __m256i x = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(pa + i)),
+                                           _mm256_loadu_si256((const __m256i*)(pb + i)));
+        const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low));
+        const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    *count = (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return i / sizeof(bitset_type);
+}
+
+// returns true if a[i] & b[i] is zero for every word, or a[i] & ~b[i] if subset is true.
+__attribute__((target("avx2")))
+static bool _test_avx2(const bitset_type* a, const bitset_type* b, size_t n, bool subset, size_t* done)
+{
+    const size_t nbytes = n * sizeof(bitset_type);
+    const char* pa = (const char*)a;
+    const char* pb = (const char*)b;
+
+    size_t i = 0;
+    for (; i + 32 <= nbytes; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(pa + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(pb + i));
+        // testc(y, x) checks ~y & x == 0 and testz(x, y) checks x & y == 0.
+        const int ok = subset ? _mm256_testc_si256(y, x) : _mm256_testz_si256(x, y);
+        if (!ok) {
+            return false;
+        }
+    }
+    *done = i / sizeof(bitset_type);
+    return true;
+}
+
+#endif
+
+static void _combine(bitset_type* out, const bitset_type* a, const bitset_type* b, size_t n, _set_op op)
+{
+    size_t done = 0;
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        done = _combine_avx2(out, a, b, n, op);
+    } else if (__builtin_cpu_supports("sse2")) {
+        done = _combine_sse2(out, a, b, n, op);
+    }
+#endif
+    _combine_scalar(out + done, a + done, b + done, n - done, op);
+}
+
+// returns the number of set bits in a[i] & b[i]. Passing the same array twice counts its bits.
+static size_t _and_count(const bitset_type* a, const bitset_type* b, size_t n)
+{
+    size_t done = 0;
+    size_t count = 0;
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        done = _and_count_avx2(a, b, n, &count);
+    } else if (__builtin_cpu_supports("sse2")) {
+        done = _and_count_sse2(a, b, n, &count);
+    }
+    if (__builtin_cpu_supports("popcnt")) {
+        return count + _and_count_popcnt(a + done, b + done, n - done);
+    }
+#endif
+    return count + _and_count_scalar(a + done, b + done, n - done);
+}
+
+static size_t _scan_rank(const bitset_type* w, size_t n, size_t* k)
+{
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("popcnt")) {
+        return _scan_rank_popcnt(w, n, k);
+    }
+#endif
+    return _scan_rank_scalar(w, n, k);
+}
+
+// returns true if no word of a shares a bit with b or, if subset is true, if every bit of a is also in b.
+static bool _test(const bitset_type* a, const bitset_type* b, size_t n, bool subset)
+{
+    size_t done = 0;
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("avx2") && !_test_avx2(a, b, n, subset, &done)) {
+        return false;
+    }
+#endif
+    for (size_t i = done; i < n; ++i) {
+        const bitset_type rest = subset ? a[i] & ~b[i] : a[i] & b[i];
+        if (rest != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t _min(size_t a, size_t b)
+{
+    return a < b ? a : b;
+}
+
 cbitset* csc_cbitset_create(size_t nbits)
 {
+    return csc_cbitset_create_with_allocator(nbits, csc_default_allocator());
+}
+
+cbitset* csc_cbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+
     // zero sized bitset is not allowed.
     if (nbits == 0) {
         return NULL;
     }
 
     // find the number of elements needed to store the number of bits.
-    int n_elems = 0;
-    if ((nbits % CSC_BITSIZE) == 0) {
-        n_elems = nbits / CSC_BITSIZE;
-    } else {
-        n_elems = (nbits / CSC_BITSIZE) + 1;
-    }
+    const size_t n_elems = _elems_for(nbits);
 
     // Performance Optimization: 
     // create a single block of memory that holds the bitset first
     // and the bitset array immediately afterwards.
-    char* data = calloc(1, (n_elems * sizeof(bitset_type)) + sizeof(cbitset));
+    char* data = allocator->alloc(_block_size(n_elems), allocator->context);
     if (data == NULL) {
         return NULL;
     }
+    memset(data, 0, _block_size(n_elems));
 
     cbitset* b = (cbitset*)data;
     b->data = (bitset_type*)(data + sizeof(cbitset));
     b->nbits = nbits;
     b->size = n_elems;
+    b->capacity = n_elems;
+    b->allocator = *allocator;
 
     return b;
 }
@@ -60,7 +437,219 @@ cbitset* csc_cbitset_create(size_t nbits)
 void csc_cbitset_destroy(cbitset* b)
 {
     assert(b != NULL);
-    free(b);
+    const csc_allocator a = b->allocator;
+    a.free(b->index, _index_size(b->size), a.context);
+
+    // a view only owns the bitset itself, not the words it points to.
+    a.free(b, _block_size(b->view ? 0 : b->capacity), a.context);
+}
+
+CSCError csc_cbitset_resize(cbitset** bp, size_t nbits)
+{
+    assert(bp != NULL && *bp != NULL);
+    cbitset* b = *bp;
+    if (nbits == 0 || nbits > SIZE_MAX - CSC_BITSIZE || b->view) {
+        return E_INVALIDOPERATION;
+    }
+
+    const size_t n_elems = _elems_for(nbits);
+    if (n_elems > b->capacity) {
+        // grow geometrically so repeatedly growing by a few bits only reallocates a logarithmic number of times.
+        size_t capacity = b->capacity + (b->capacity / 2);
+        if (capacity < n_elems) {
+            capacity = n_elems;
+        }
+        if (capacity > (SIZE_MAX - sizeof(cbitset)) / sizeof(bitset_type)) {
+            capacity = n_elems;
+        }
+
+        const csc_allocator* a = &(b->allocator);
+        cbitset* grown = a->realloc(b, _block_size(b->capacity), _block_size(capacity), a->context);
+        if (grown == NULL) {
+            return E_OUTOFMEM;
+        }
+        b = grown;
+        b->data = (bitset_type*)((char*)b + sizeof(cbitset));
+        b->capacity = capacity;
+        *bp = b;
+    }
+
+    // elements past the old size may hold stale bits from an earlier shrink so clear them.
+    if (n_elems > b->size) {
+        memset(b->data + b->size, 0, (n_elems - b->size) * sizeof(bitset_type));
+    }
+
+    // keep the bits past the new end of the last element clear.
+    const size_t tail = nbits % CSC_BITSIZE;
+    if (tail != 0 && nbits < b->nbits) {
+        b->data[n_elems - 1] &= ((bitset_type)1 << tail) - 1;
+    }
+
+    // the rank index is sized for the old number of elements.
+    if (n_elems != b->size) {
+        b->allocator.free(b->index, _index_size(b->size), b->allocator.context);
+        b->index = NULL;
+    }
+    b->indexed = false;
+    b->nbits = nbits;
+    b->size = n_elems;
+
+    return E_NOERR;
+}
+
+// writes the header of a serialized bitset.
+static void _serial_header_init(const cbitset* b, _serial_header* h)
+{
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, CSC_SERIAL_MAGIC, sizeof(h->magic));
+    h->version = CSC_SERIAL_VERSION;
+    h->word_size = sizeof(bitset_type);
+    h->nbits = b->nbits;
+}
+
+// checks the header of a serialized bitset and returns the number of bits it holds.
+static CSCError _serial_validate(const void* buf, size_t len, size_t* nbits)
+{
+    // the buffer may not be aligned, so the header is copied out before it is read.
+    _serial_header h;
+    if (len < sizeof(h)) {
+        return E_INVALIDOPERATION;
+    }
+    memcpy(&h, buf, sizeof(h));
+
+    const size_t max_elems = (len - sizeof(h)) / sizeof(bitset_type);
+    if (memcmp(h.magic, CSC_SERIAL_MAGIC, sizeof(h.magic)) != 0 || h.version != CSC_SERIAL_VERSION
+        || h.word_size != sizeof(bitset_type) || h.nbits == 0 || h.nbits / CSC_BITSIZE > max_elems
+        || _elems_for((size_t)h.nbits) > max_elems) {
+        return E_INVALIDOPERATION;
+    }
+    *nbits = (size_t)h.nbits;
+
+    return E_NOERR;
+}
+
+size_t csc_cbitset_serialized_size(const cbitset* b)
+{
+    assert(b != NULL);
+    return sizeof(_serial_header) + (b->size * sizeof(bitset_type));
+}
+
+CSCError csc_cbitset_serialize(const cbitset* b, void* buf, size_t len)
+{
+    assert(b != NULL && buf != NULL);
+    if (len < csc_cbitset_serialized_size(b)) {
+        return E_OUTOFRANGE;
+    }
+
+    _serial_header h;
+    _serial_header_init(b, &h);
+    memcpy(buf, &h, sizeof(h));
+    memcpy((char*)buf + sizeof(h), b->data, b->size * sizeof(bitset_type));
+
+    return E_NOERR;
+}
+
+#ifdef CSC_POSIX_IO
+
+// writes every byte of buf, retrying short and interrupted writes.
+static CSCError _write_all(int fd, const char* buf, size_t len)
+{
+    while (len > 0) {
+        const ssize_t written = write(fd, buf, len);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return E_IO;
+        }
+        buf += written;
+        len -= (size_t)written;
+    }
+    return E_NOERR;
+}
+
+#endif
+
+CSCError csc_cbitset_write(const cbitset* b, int fd)
+{
+    assert(b != NULL);
+#ifdef CSC_POSIX_IO
+    _serial_header h;
+    _serial_header_init(b, &h);
+    CSCError e = _write_all(fd, (const char*)&h, sizeof(h));
+    if (e != E_NOERR) {
+        return e;
+    }
+    return _write_all(fd, (const char*)b->data, b->size * sizeof(bitset_type));
+#else
+    CSC_UNUSED(fd);
+    return E_IO;
+#endif
+}
+
+cbitset* csc_cbitset_deserialize(const void* buf, size_t len, CSCError* e)
+{
+    assert(buf != NULL);
+    size_t nbits = 0;
+    CSCError err = _serial_validate(buf, len, &nbits);
+    cbitset* b = NULL;
+    if (err == E_NOERR) {
+        b = csc_cbitset_create(nbits);
+        if (b == NULL) {
+            err = E_OUTOFMEM;
+        } else {
+            memcpy(b->data, (const char*)buf + sizeof(_serial_header), b->size * sizeof(bitset_type));
+
+            // keep the bits past the end of the bitset cleared.
+            const size_t tail = nbits % CSC_BITSIZE;
+            if (tail != 0) {
+                b->data[b->size - 1] &= ((bitset_type)1 << tail) - 1;
+            }
+        }
+    }
+
+    if (e != NULL) {
+        *e = err;
+    }
+    return b;
+}
+
+cbitset* csc_cbitset_view(void* buf, size_t len, CSCError* e)
+{
+    assert(buf != NULL);
+    size_t nbits = 0;
+    CSCError err = _serial_validate(buf, len, &nbits);
+    bitset_type* data = (bitset_type*)((char*)buf + sizeof(_serial_header));
+    const size_t n_elems = _elems_for(nbits);
+    const size_t tail = nbits % CSC_BITSIZE;
+
+    // the words are used in place, so they must be aligned and already satisfy the bitset's invariants.
+    if (err == E_NOERR && ((uintptr_t)data % sizeof(bitset_type) != 0
+        || (tail != 0 && (data[n_elems - 1] >> tail) != 0))) {
+        err = E_INVALIDOPERATION;
+    }
+
+    cbitset* b = NULL;
+    if (err == E_NOERR) {
+        const csc_allocator* a = csc_default_allocator();
+        b = a->alloc(_block_size(0), a->context);
+        if (b == NULL) {
+            err = E_OUTOFMEM;
+        } else {
+            memset(b, 0, sizeof(*b));
+            b->data = data;
+            b->nbits = nbits;
+            b->size = n_elems;
+            b->capacity = n_elems;
+            b->allocator = *a;
+            b->view = true;
+        }
+    }
+
+    if (e != NULL) {
+        *e = err;
+    }
+    return b;
 }
 
 size_t csc_cbitset_size(const cbitset* b)
@@ -78,7 +667,8 @@ CSCError csc_cbitset_set(cbitset* b, size_t bit)
     
     bitset_type* elem = &(b->data[bit / CSC_BITSIZE]);
     const bitset_type shift = bit % CSC_BITSIZE;
-    *elem |= 1 << shift;
+    b->indexed = false;
+    *elem |= (bitset_type)1 << shift;
 
     return E_NOERR;
 }
@@ -92,7 +682,8 @@ CSCError csc_cbitset_clear(cbitset* b, size_t bit)
 
     bitset_type* elem = &(b->data[bit / CSC_BITSIZE]);
     const bitset_type shift = bit % CSC_BITSIZE;
-    *elem &= ~(1 << shift);
+    b->indexed = false;
+    *elem &= ~((bitset_type)1 << shift);
 
     return E_NOERR;
 }
@@ -106,7 +697,8 @@ CSCError csc_cbitset_flip(cbitset* b, size_t bit)
 
     bitset_type* elem = &(b->data[bit / CSC_BITSIZE]);
     const bitset_type shift = bit % CSC_BITSIZE;
-    *elem ^= (1 << shift);
+    b->indexed = false;
+    *elem ^= ((bitset_type)1 << shift);
 
     return E_NOERR;
 }
@@ -125,17 +717,418 @@ bool csc_cbitset_at(const cbitset* b, size_t bit, CSCError* e)
     // bit 64 to 127 = elem 1
     const bitset_type elem = b->data[bit / CSC_BITSIZE];
     const bitset_type shift = bit % CSC_BITSIZE;
-    return (elem & (1 << shift)) != 0;
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return (elem & ((bitset_type)1 << shift)) != 0;
 }
 
 void csc_cbitset_set_all(cbitset* b)
 {
     assert(b != NULL);
+    b->indexed = false;
     memset(b->data, ~0, b->size * sizeof(*(b->data)));
+
+    // keep the unused bits of the last element cleared so word-wise scans never see bits past nbits.
+    const size_t tail = b->nbits % CSC_BITSIZE;
+    if (tail != 0) {
+        b->data[b->size - 1] = ((bitset_type)1 << tail) - 1;
+    }
 }
 
 void csc_cbitset_clear_all(cbitset* b)
 {
     assert(b != NULL);
+    b->indexed = false;
     memset(b->data, 0, b->size * sizeof(*(b->data)));
-}
\ No newline at end of file
+}
+
+// applies the operation to the bits of the word selected by the mask.
+static void _apply_mask(bitset_type* elem, bitset_type mask, _range_op op)
+{
+    switch (op) {
+    case _RANGE_SET:
+        *elem |= mask;
+        break;
+    case _RANGE_CLEAR:
+        *elem &= ~mask;
+        break;
+    case _RANGE_FLIP:
+        *elem ^= mask;
+        break;
+    }
+}
+
+// applies the operation to the bits in [first, last) a whole word at a time, masking the partial words at the edges.
+static CSCError _apply_range(cbitset* b, size_t first, size_t last, _range_op op)
+{
+    assert(b != NULL);
+    if (first > last || last > b->nbits) {
+        return E_OUTOFRANGE;
+    }
+    if (first == last) {
+        return E_NOERR;
+    }
+    b->indexed = false;
+
+    const size_t first_elem = first / CSC_BITSIZE;
+    const size_t last_elem = (last - 1) / CSC_BITSIZE;
+    const bitset_type first_mask = ~(bitset_type)0 << (first % CSC_BITSIZE);
+    const bitset_type last_mask = ~(bitset_type)0 >> (CSC_BITSIZE - 1 - ((last - 1) % CSC_BITSIZE));
+
+    if (first_elem == last_elem) {
+        _apply_mask(&(b->data[first_elem]), first_mask & last_mask, op);
+        return E_NOERR;
+    }
+
+    _apply_mask(&(b->data[first_elem]), first_mask, op);
+    bitset_type* inner = &(b->data[first_elem + 1]);
+    const size_t n_inner = last_elem - first_elem - 1;
+    switch (op) {
+    case _RANGE_SET:
+        memset(inner, ~0, n_inner * sizeof(bitset_type));
+        break;
+    case _RANGE_CLEAR:
+        memset(inner, 0, n_inner * sizeof(bitset_type));
+        break;
+    case _RANGE_FLIP:
+        for (size_t i = 0; i < n_inner; ++i) {
+            inner[i] = ~inner[i];
+        }
+        break;
+    }
+    _apply_mask(&(b->data[last_elem]), last_mask, op);
+
+    return E_NOERR;
+}
+
+CSCError csc_cbitset_set_range(cbitset* b, size_t first, size_t last)
+{
+    return _apply_range(b, first, last, _RANGE_SET);
+}
+
+CSCError csc_cbitset_clear_range(cbitset* b, size_t first, size_t last)
+{
+    return _apply_range(b, first, last, _RANGE_CLEAR);
+}
+
+CSCError csc_cbitset_flip_range(cbitset* b, size_t first, size_t last)
+{
+    return _apply_range(b, first, last, _RANGE_FLIP);
+}
+
+size_t csc_cbitset_word_count(const cbitset* b)
+{
+    assert(b != NULL);
+    return b->size;
+}
+
+cbitset_word csc_cbitset_get_word(const cbitset* b, size_t idx, CSCError* e)
+{
+    assert(b != NULL);
+    if (idx >= b->size) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return 0;
+    }
+
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return b->data[idx];
+}
+
+CSCError csc_cbitset_set_word(cbitset* b, size_t idx, cbitset_word word)
+{
+    assert(b != NULL);
+    if (idx >= b->size) {
+        return E_OUTOFRANGE;
+    }
+
+    // drop the bits of the last word that lie past nbits.
+    const size_t tail = b->nbits % CSC_BITSIZE;
+    if (idx == b->size - 1 && tail != 0) {
+        word &= ((bitset_type)1 << tail) - 1;
+    }
+    b->data[idx] = word;
+    b->indexed = false;
+
+    return E_NOERR;
+}
+
+cbitset_word* csc_cbitset_words(cbitset* b)
+{
+    assert(b != NULL);
+    b->indexed = false;
+    return b->data;
+}
+
+CSCError csc_cbitset_build_index(cbitset* b)
+{
+    assert(b != NULL);
+    const csc_allocator* a = &(b->allocator);
+    if (b->index == NULL) {
+        b->index = a->alloc(_index_size(b->size), a->context);
+        if (b->index == NULL) {
+            return E_OUTOFMEM;
+        }
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < b->size; i += CSC_SUPERBLOCK_WORDS) {
+        b->index[i / CSC_SUPERBLOCK_WORDS] = count;
+        const size_t n = b->size - i < CSC_SUPERBLOCK_WORDS ? b->size - i : CSC_SUPERBLOCK_WORDS;
+        count += _and_count(b->data + i, b->data + i, n);
+    }
+    b->index[(b->size + CSC_SUPERBLOCK_WORDS - 1) / CSC_SUPERBLOCK_WORDS] = count;
+    b->indexed = true;
+
+    return E_NOERR;
+}
+
+size_t csc_cbitset_count(const cbitset* b)
+{
+    assert(b != NULL);
+    if (b->indexed) {
+        return b->index[(b->size + CSC_SUPERBLOCK_WORDS - 1) / CSC_SUPERBLOCK_WORDS];
+    }
+
+    return _and_count(b->data, b->data, b->size);
+}
+
+size_t csc_cbitset_rank(const cbitset* b, size_t bit, CSCError* e)
+{
+    assert(b != NULL);
+    if (bit > b->nbits) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return 0;
+    }
+
+    const size_t elem = bit / CSC_BITSIZE;
+    size_t first = 0;
+    size_t count = 0;
+    if (b->indexed) {
+        // start from the superblock holding the bit so at most CSC_SUPERBLOCK_WORDS words are counted.
+        first = elem - (elem % CSC_SUPERBLOCK_WORDS);
+        count = b->index[elem / CSC_SUPERBLOCK_WORDS];
+    }
+    count += _and_count(b->data + first, b->data + first, elem - first);
+
+    const size_t shift = bit % CSC_BITSIZE;
+    if (shift != 0) {
+        count += _popcount(b->data[elem] & (((bitset_type)1 << shift) - 1));
+    }
+
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return count;
+}
+
+// returns the index of the k-th set bit of the word. The word must have more than k set bits.
+static size_t _select_in_elem(bitset_type elem, size_t k)
+{
+    while (k-- > 0) {
+        elem &= elem - 1;
+    }
+    return csc_ctz64(elem);
+}
+
+size_t csc_cbitset_select(const cbitset* b, size_t k, CSCError* e)
+{
+    assert(b != NULL);
+    size_t i = 0;
+    if (b->indexed) {
+        // binary search for the last superblock with at most k set bits before it.
+        size_t lo = 0;
+        size_t hi = (b->size + CSC_SUPERBLOCK_WORDS - 1) / CSC_SUPERBLOCK_WORDS;
+        if (k >= b->index[hi]) {
+            i = b->size;
+        } else {
+            while (hi - lo > 1) {
+                const size_t mid = lo + ((hi - lo) / 2);
+                if (b->index[mid] <= k) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            i = lo * CSC_SUPERBLOCK_WORDS;
+            k -= b->index[lo];
+        }
+    }
+
+    if (i < b->size) {
+        i += _scan_rank(b->data + i, b->size - i, &k);
+    }
+    if (i < b->size) {
+        if (e != NULL) {
+            *e = E_NOERR;
+        }
+        return (i * CSC_BITSIZE) + _select_in_elem(b->data[i], k);
+    }
+
+    if (e != NULL) {
+        *e = E_OUTOFRANGE;
+    }
+    return b->nbits;
+}
+
+// combines a and b into out after checking that all three have the same size.
+static CSCError _combine_bitsets(cbitset* out, const cbitset* a, const cbitset* b, _set_op op)
+{
+    assert(out != NULL && a != NULL && b != NULL);
+    if (out->nbits != a->nbits || a->nbits != b->nbits) {
+        return E_INVALIDOPERATION;
+    }
+
+    _combine(out->data, a->data, b->data, out->size, op);
+    out->indexed = false;
+
+    return E_NOERR;
+}
+
+CSCError csc_cbitset_and(cbitset* dst, const cbitset* src)
+{
+    return _combine_bitsets(dst, dst, src, _OP_AND);
+}
+
+CSCError csc_cbitset_or(cbitset* dst, const cbitset* src)
+{
+    return _combine_bitsets(dst, dst, src, _OP_OR);
+}
+
+CSCError csc_cbitset_xor(cbitset* dst, const cbitset* src)
+{
+    return _combine_bitsets(dst, dst, src, _OP_XOR);
+}
+
+CSCError csc_cbitset_andnot(cbitset* dst, const cbitset* src)
+{
+    return _combine_bitsets(dst, dst, src, _OP_ANDNOT);
+}
+
+CSCError csc_cbitset_and_into(cbitset* out, const cbitset* a, const cbitset* b)
+{
+    return _combine_bitsets(out, a, b, _OP_AND);
+}
+
+CSCError csc_cbitset_or_into(cbitset* out, const cbitset* a, const cbitset* b)
+{
+    return _combine_bitsets(out, a, b, _OP_OR);
+}
+
+CSCError csc_cbitset_xor_into(cbitset* out, const cbitset* a, const cbitset* b)
+{
+    return _combine_bitsets(out, a, b, _OP_XOR);
+}
+
+CSCError csc_cbitset_andnot_into(cbitset* out, const cbitset* a, const cbitset* b)
+{
+    return _combine_bitsets(out, a, b, _OP_ANDNOT);
+}
+
+size_t csc_cbitset_and_count(const cbitset* a, const cbitset* b)
+{
+    assert(a != NULL && b != NULL);
+    return _and_count(a->data, b->data, _min(a->size, b->size));
+}
+
+bool csc_cbitset_intersects(const cbitset* a, const cbitset* b)
+{
+    assert(a != NULL && b != NULL);
+    return !_test(a->data, b->data, _min(a->size, b->size), false);
+}
+
+bool csc_cbitset_is_subset(const cbitset* a, const cbitset* b)
+{
+    assert(a != NULL && b != NULL);
+    const size_t common = _min(a->size, b->size);
+    if (!_test(a->data, b->data, common, true)) {
+        return false;
+    }
+
+    // the bits of a past the end of b must all be clear.
+    for (size_t i = common; i < a->size; ++i) {
+        if (a->data[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// returns the first bit at or after from that is set in the data xor'ed with flip, or nbits if there is none.
+static size_t _find_next(const cbitset* b, size_t from, bitset_type flip)
+{
+    assert(b != NULL);
+    if (from >= b->nbits) {
+        return b->nbits;
+    }
+
+    size_t i = from / CSC_BITSIZE;
+    bitset_type elem = (b->data[i] ^ flip) & (~(bitset_type)0 << (from % CSC_BITSIZE));
+    while (elem == 0) {
+        if (++i >= b->size) {
+            return b->nbits;
+        }
+        elem = b->data[i] ^ flip;
+    }
+
+    // flipped padding bits of the last element show up as zeros past nbits.
+    const size_t bit = (i * CSC_BITSIZE) + csc_ctz64(elem);
+    return bit < b->nbits ? bit : b->nbits;
+}
+
+size_t csc_cbitset_find_first(const cbitset* b)
+{
+    return _find_next(b, 0, 0);
+}
+
+size_t csc_cbitset_find_next(const cbitset* b, size_t from)
+{
+    return _find_next(b, from, 0);
+}
+
+size_t csc_cbitset_find_first_zero(const cbitset* b)
+{
+    return _find_next(b, 0, ~(bitset_type)0);
+}
+
+size_t csc_cbitset_find_next_zero(const cbitset* b, size_t from)
+{
+    return _find_next(b, from, ~(bitset_type)0);
+}
+
+void csc_cbitset_foreach(const cbitset* b, csc_bit_foreach fn, void* context)
+{
+    assert(b != NULL);
+    for (size_t i = 0; i < b->size; ++i) {
+        bitset_type elem = b->data[i];
+        while (elem != 0) {
+            fn((i * CSC_BITSIZE) + csc_ctz64(elem), context);
+            elem &= elem - 1;
+        }
+    }
+}
+
+csc_cbitset_iter csc_cbitset_iter_begin(const cbitset* b)
+{
+    assert(b != NULL);
+    csc_cbitset_iter it;
+    it.words = b->data;
+    it.nwords = b->size;
+    it.word = 0;
+    it.rest = b->data[0];
+    it.bit = 0;
+    if (it.rest == 0) {
+        // find the first non-zero word, if any, and position the iterator on its lowest bit.
+        it.rest = 1;
+        csc_cbitset_iter_next(&it);
+    } else {
+        it.bit = csc_ctz64(it.rest);
+    }
+    return it;
+}
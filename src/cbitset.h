@@ -54,6 +54,18 @@
 
 #include "csc.h"
 
+/**
+ * @brief the word type the bits of a #cbitset are stored in.
+ * 
+ * Bit @c i of the bitset is bit <tt>i % (8 * sizeof(cbitset_word))</tt> of word <tt>i / (8 * sizeof(cbitset_word))</tt>.
+ * 
+ */
+#ifdef CSC_64
+    typedef uint_fast64_t cbitset_word;
+#else
+    typedef uint_fast32_t cbitset_word;
+#endif
+
 /**
  * @brief the cbitset data structure.
  * 
@@ -64,6 +76,14 @@
  */
 typedef struct cbitset cbitset;
 
+/**
+ * @brief callback function applied to the index of each set bit by #csc_cbitset_foreach.
+ * 
+ * @param bit the 0-indexed bit.
+ * @param context user-defined data passed through from #csc_cbitset_foreach.
+ */
+typedef void (*csc_bit_foreach)(size_t bit, void* context);
+
 /**
  * @brief creates a #cbitset.
  * 
@@ -79,6 +99,21 @@ typedef struct cbitset cbitset;
  */
 cbitset* csc_cbitset_create(size_t nbits);
 
+/**
+ * @brief creates a #cbitset using a custom allocator.
+ * 
+ * This function is identical to #csc_cbitset_create except that the bitset is allocated through @p allocator.
+ * 
+ * @param nbits the number of bits the bitset should manage.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a #cbitset if successful. On failure or if @p nbits is 0, @c NULL is returned.
+ * 
+ * @see csc_cbitset_destroy
+ * 
+ */
+cbitset* csc_cbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator);
+
 /**
  * @brief destroys a #cbitset.
  * 
@@ -108,6 +143,123 @@ void csc_cbitset_destroy(cbitset* b);
  */
 size_t csc_cbitset_size(const cbitset* b);
 
+/**
+ * @brief changes the number of bits the bitset holds.
+ * 
+ * The bitset and its bits live in a single block of memory, so growing the bitset may move it. On success,
+ * @p *bp is updated to point to the resized bitset and the old pointer must no longer be used.
+ * 
+ * Existing bits below the new size keep their values and any new bits are clear. The block grows geometrically, so
+ * growing the bitset a few bits at a time has an amortized cost proportional to the number of new bits. Shrinking
+ * never releases memory. Resizing makes the rank index stale.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) worst case. @c O(1) amortized per new word when growing.
+ * 
+ * @param bp the address of the bitset.
+ * @param nbits the new number of bits. Must be greater than 0.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p nbits is 0 or the bitset is a view created by #csc_cbitset_view,
+ * @c CSCError#E_INVALIDOPERATION. If the bitset couldn't be reallocated, @c CSCError#E_OUTOFMEM and the bitset is
+ * left unchanged.
+ * 
+ * @see csc_cbitset_build_index
+ */
+CSCError csc_cbitset_resize(cbitset** bp, size_t nbits);
+
+/**
+ * @brief returns the number of bytes #csc_cbitset_serialize writes.
+ * 
+ * A serialized bitset is a 32 byte header holding the number of bits and the word size, followed by the words of
+ * the bitset in native byte order. Since the words start 32 bytes into the buffer, a serialized bitset that is
+ * mapped into memory can be used in place with #csc_cbitset_view.
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * 
+ * @return the size of the serialized bitset in bytes.
+ */
+size_t csc_cbitset_serialized_size(const cbitset* b);
+
+/**
+ * @brief writes the bitset to a buffer.
+ * 
+ * See #csc_cbitset_serialized_size for the layout.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param buf the buffer to write to. Must be @b non-null.
+ * @param len the size of @p buf in bytes.
+ * 
+ * @return On success, @c CSCError#E_NOERR. If @p len is smaller than #csc_cbitset_serialized_size,
+ * @c CSCError#E_OUTOFRANGE.
+ */
+CSCError csc_cbitset_serialize(const cbitset* b, void* buf, size_t len);
+
+/**
+ * @brief writes the bitset to a file descriptor.
+ * 
+ * The same bytes as #csc_cbitset_serialize are written at the current position of @p fd without an intermediate
+ * buffer. This is only supported on POSIX systems.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param fd an open file descriptor.
+ * 
+ * @return On success, @c CSCError#E_NOERR. If writing fails or file descriptors aren't supported,
+ * @c CSCError#E_IO.
+ */
+CSCError csc_cbitset_write(const cbitset* b, int fd);
+
+/**
+ * @brief creates a #cbitset from a buffer written by #csc_cbitset_serialize.
+ * 
+ * The words are copied into a new bitset. Use #csc_cbitset_view to use the buffer in place instead.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param buf the buffer to read. Must be @b non-null.
+ * @param len the size of @p buf in bytes.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ * 
+ * @return a pointer to a #cbitset if successful and @c NULL otherwise. On success, @p e is @c CSCError#E_NOERR. If
+ * the buffer doesn't hold a serialized bitset with the native word size, @p e is @c CSCError#E_INVALIDOPERATION. If
+ * memory couldn't be allocated, @p e is @c CSCError#E_OUTOFMEM.
+ * 
+ * @see csc_cbitset_destroy
+ */
+cbitset* csc_cbitset_deserialize(const void* buf, size_t len, CSCError* e);
+
+/**
+ * @brief creates a #cbitset that uses the words of a serialized bitset in place.
+ * 
+ * No words are copied, so loading a large bitset from a file is as cheap as mapping the file:
+ * 
+ * @code
+ * void* buf = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+ * cbitset* b = csc_cbitset_view(buf, len, &e);
+ * @endcode
+ * 
+ * Changes to the bitset are made directly to @p buf, which must stay valid and, if the bitset is modified,
+ * writable until the view is destroyed. Destroying the view doesn't release @p buf. A view can't be resized.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param buf the buffer holding the serialized bitset. Must be @b non-null and aligned to a #cbitset_word.
+ * @param len the size of @p buf in bytes.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ * 
+ * @return a pointer to a #cbitset if successful and @c NULL otherwise. On success, @p e is @c CSCError#E_NOERR. If
+ * the buffer doesn't hold a serialized bitset with the native word size, is misaligned or has bits set past the
+ * size of the bitset, @p e is @c CSCError#E_INVALIDOPERATION. If memory couldn't be allocated, @p e is
+ * @c CSCError#E_OUTOFMEM.
+ * 
+ * @see csc_cbitset_destroy
+ */
+cbitset* csc_cbitset_view(void* buf, size_t len, CSCError* e);
+
 /**
  * @brief sets the 0-indexed bit supplied in the bitset.
  * 
@@ -192,4 +344,525 @@ void csc_cbitset_set_all(cbitset* b);
  * @param b the bitset.
  * 
  */
-void csc_cbitset_clear_all(cbitset* b);
\ No newline at end of file
+void csc_cbitset_clear_all(cbitset* b);
+
+/**
+ * @brief sets the bits in the 0-indexed range [@p first, @p last).
+ * 
+ * The range is updated a whole word at a time, masking only the partial words at either end, so this is much
+ * faster than calling #csc_cbitset_set for each bit.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) where @c n is the number of words the range spans.
+ * 
+ * @param b the bitset.
+ * @param first the index of the first bit to set.
+ * @param last the index one past the last bit to set.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p first is greater than @p last or @p last is greater than the size
+ * of the bitset, @c CSCError#E_OUTOFRANGE and the bitset is left unchanged.
+ */
+CSCError csc_cbitset_set_range(cbitset* b, size_t first, size_t last);
+
+/**
+ * @brief clears the bits in the 0-indexed range [@p first, @p last).
+ * 
+ * See #csc_cbitset_set_range for more details.
+ * 
+ * @param b the bitset.
+ * @param first the index of the first bit to clear.
+ * @param last the index one past the last bit to clear.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p first is greater than @p last or @p last is greater than the size
+ * of the bitset, @c CSCError#E_OUTOFRANGE and the bitset is left unchanged.
+ */
+CSCError csc_cbitset_clear_range(cbitset* b, size_t first, size_t last);
+
+/**
+ * @brief flips the bits in the 0-indexed range [@p first, @p last).
+ * 
+ * See #csc_cbitset_set_range for more details.
+ * 
+ * @param b the bitset.
+ * @param first the index of the first bit to flip.
+ * @param last the index one past the last bit to flip.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p first is greater than @p last or @p last is greater than the size
+ * of the bitset, @c CSCError#E_OUTOFRANGE and the bitset is left unchanged.
+ */
+CSCError csc_cbitset_flip_range(cbitset* b, size_t first, size_t last);
+
+/**
+ * @brief returns the number of words the bitset is stored in.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param b the bitset.
+ * 
+ * @return the number of #cbitset_word words.
+ */
+size_t csc_cbitset_word_count(const cbitset* b);
+
+/**
+ * @brief returns a whole word of the bitset.
+ * 
+ * Word @p idx holds the bits starting at <tt>idx * 8 * sizeof(cbitset_word)</tt>, with the lowest bit first.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param idx the 0-indexed word.
+ * @param e an optional error code. Can be @c NULL. If non-null, set to @c CSCError#E_NOERR on success and
+ * @c CSCError#E_OUTOFRANGE if @p idx is out of range.
+ * 
+ * @return the word or 0 if @p idx is out of range.
+ */
+cbitset_word csc_cbitset_get_word(const cbitset* b, size_t idx, CSCError* e);
+
+/**
+ * @brief replaces a whole word of the bitset.
+ * 
+ * Bits of the last word that lie past the size of the bitset are ignored.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param b the bitset.
+ * @param idx the 0-indexed word.
+ * @param word the new value of the word.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p idx is out of range, @c CSCError#E_OUTOFRANGE.
+ */
+CSCError csc_cbitset_set_word(cbitset* b, size_t idx, cbitset_word word);
+
+/**
+ * @brief returns the words the bitset is stored in.
+ * 
+ * This gives containers built on top of a bitset direct access to its storage. Word @c i is laid out as described
+ * in #csc_cbitset_get_word and there are #csc_cbitset_word_count words. Bits of the last word that lie past the
+ * size of the bitset must be kept cleared.
+ * 
+ * Calling this function invalidates the rank index. Call #csc_cbitset_build_index again after modifying the words
+ * if the index is needed. The pointer is invalidated by #csc_cbitset_resize and #csc_cbitset_destroy.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * 
+ * @return a pointer to the first word.
+ */
+cbitset_word* csc_cbitset_words(cbitset* b);
+
+/**
+ * @brief returns the number of set bits in the bitset.
+ * 
+ * Bits are counted with AVX2, SSE2 or the popcnt instruction, whichever the CPU supports, chosen at runtime. If the
+ * rank index is up to date, the count is read from the index instead.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n). @c O(1) with an up to date rank index.
+ * 
+ * @param b the bitset.
+ * 
+ * @return the number of set bits.
+ * 
+ * @see csc_cbitset_build_index
+ */
+size_t csc_cbitset_count(const cbitset* b);
+
+/**
+ * @brief builds the auxiliary index used to speed up rank and select queries.
+ * 
+ * The index stores the number of set bits before every superblock of 8 words, which costs one @c size_t per
+ * 512 bits on 64 bit platforms. With an up to date index, #csc_cbitset_rank runs in constant time,
+ * #csc_cbitset_select in logarithmic time and #csc_cbitset_count in constant time.
+ * 
+ * Any function that modifies the bitset makes the index stale, after which the queries fall back to scanning the
+ * bitset until this function is called again. Build the index once a bitset stops changing, or after a batch of
+ * modifications, and query it many times.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param b the bitset.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the index couldn't be allocated, @c CSCError#E_OUTOFMEM.
+ */
+CSCError csc_cbitset_build_index(cbitset* b);
+
+/**
+ * @brief returns the number of set bits before the specified bit.
+ * 
+ * This counts the set bits in the range [0, @p bit). For example, if the bitset maps ids to whether they are live,
+ * the rank of an id is the number of live ids before it.
+ * 
+ * <b>Time Complexity:</b> @c O(n). @c O(1) with an up to date rank index.
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param bit the 0-indexed bit. May be equal to the size of the bitset to count every bit.
+ * @param e an optional error code. Can be @c NULL. If non-null, set to @c CSCError#E_NOERR on success and
+ * @c CSCError#E_OUTOFRANGE if @p bit is greater than the size of the bitset.
+ * 
+ * @return the number of set bits before @p bit or 0 if @p bit is out of range.
+ * 
+ * @see csc_cbitset_build_index
+ */
+size_t csc_cbitset_rank(const cbitset* b, size_t bit, CSCError* e);
+
+/**
+ * @brief returns the index of the @p k -th set bit.
+ * 
+ * @p k is 0-indexed so @c csc_cbitset_select(b, 0, NULL) returns the lowest set bit. This is the inverse of
+ * #csc_cbitset_rank: for every set bit @c i, <tt>csc_cbitset_select(b, csc_cbitset_rank(b, i, NULL), NULL) == i</tt>.
+ * 
+ * <b>Time Complexity:</b> @c O(n). @c O(log(n)) with an up to date rank index.
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param k the number of set bits to skip.
+ * @param e an optional error code. Can be @c NULL. If non-null, set to @c CSCError#E_NOERR on success and
+ * @c CSCError#E_OUTOFRANGE if the bitset has @p k or fewer set bits.
+ * 
+ * @return the index of the bit or the size of the bitset if there are @p k or fewer set bits.
+ * 
+ * @see csc_cbitset_build_index
+ */
+size_t csc_cbitset_select(const cbitset* b, size_t k, CSCError* e);
+
+/**
+ * @brief replaces @p dst with the intersection of @p dst and @p src.
+ * 
+ * Each word becomes <tt>dst & src</tt>. The words are combined with AVX2 or SSE2 instructions when the CPU supports
+ * them and with a scalar loop otherwise. Both bitsets must have the same size.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param dst the bitset to update.
+ * @param src the other operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p dst is left unchanged.
+ */
+CSCError csc_cbitset_and(cbitset* dst, const cbitset* src);
+
+/**
+ * @brief replaces @p dst with the union of @p dst and @p src.
+ * 
+ * Each word becomes <tt>dst | src</tt>. See #csc_cbitset_and for more details.
+ * 
+ * @param dst the bitset to update.
+ * @param src the other operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p dst is left unchanged.
+ */
+CSCError csc_cbitset_or(cbitset* dst, const cbitset* src);
+
+/**
+ * @brief replaces @p dst with the symmetric difference of @p dst and @p src.
+ * 
+ * Each word becomes <tt>dst ^ src</tt>. See #csc_cbitset_and for more details.
+ * 
+ * @param dst the bitset to update.
+ * @param src the other operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p dst is left unchanged.
+ */
+CSCError csc_cbitset_xor(cbitset* dst, const cbitset* src);
+
+/**
+ * @brief replaces @p dst with the difference of @p dst and @p src.
+ * 
+ * Each word becomes <tt>dst & ~src</tt>. See #csc_cbitset_and for more details.
+ * 
+ * @param dst the bitset to update.
+ * @param src the other operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p dst is left unchanged.
+ */
+CSCError csc_cbitset_andnot(cbitset* dst, const cbitset* src);
+
+/**
+ * @brief stores the intersection of @p a and @p b in @p out.
+ * 
+ * Each word of @p out becomes <tt>a & b</tt>. @p out may be the same bitset as @p a or @p b. All three bitsets
+ * must have the same size. See #csc_cbitset_and for more details.
+ * 
+ * @param out the bitset receiving the result.
+ * @param a the first operand.
+ * @param b the second operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p out is left unchanged.
+ */
+CSCError csc_cbitset_and_into(cbitset* out, const cbitset* a, const cbitset* b);
+
+/**
+ * @brief stores the union of @p a and @p b in @p out.
+ * 
+ * Each word of @p out becomes <tt>a | b</tt>. @p out may be the same bitset as @p a or @p b. All three bitsets
+ * must have the same size. See #csc_cbitset_or for more details.
+ * 
+ * @param out the bitset receiving the result.
+ * @param a the first operand.
+ * @param b the second operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p out is left unchanged.
+ */
+CSCError csc_cbitset_or_into(cbitset* out, const cbitset* a, const cbitset* b);
+
+/**
+ * @brief stores the symmetric difference of @p a and @p b in @p out.
+ * 
+ * Each word of @p out becomes <tt>a ^ b</tt>. @p out may be the same bitset as @p a or @p b. All three bitsets
+ * must have the same size. See #csc_cbitset_xor for more details.
+ * 
+ * @param out the bitset receiving the result.
+ * @param a the first operand.
+ * @param b the second operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p out is left unchanged.
+ */
+CSCError csc_cbitset_xor_into(cbitset* out, const cbitset* a, const cbitset* b);
+
+/**
+ * @brief stores the difference of @p a and @p b in @p out.
+ * 
+ * Each word of @p out becomes <tt>a & ~b</tt>. @p out may be the same bitset as @p a or @p b. All three bitsets
+ * must have the same size. See #csc_cbitset_andnot for more details.
+ * 
+ * @param out the bitset receiving the result.
+ * @param a the first operand.
+ * @param b the second operand.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the bitsets have different sizes, @c CSCError#E_INVALIDOPERATION and
+ * @p out is left unchanged.
+ */
+CSCError csc_cbitset_andnot_into(cbitset* out, const cbitset* a, const cbitset* b);
+
+/**
+ * @brief returns the number of bits set in both bitsets.
+ * 
+ * This is the same as counting the bits of the intersection of @p a and @p b but the intersection is never
+ * stored. The words are combined and counted with AVX2 or SSE2 instructions when the CPU supports them.
+ * Bitsets of different sizes are compared as if the shorter one was padded with clear bits.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param a the first bitset.
+ * @param b the second bitset.
+ * 
+ * @return the number of bits set in both @p a and @p b.
+ */
+size_t csc_cbitset_and_count(const cbitset* a, const cbitset* b);
+
+/**
+ * @brief checks if the bitsets have a set bit in common.
+ * 
+ * The scan stops at the first common bit. Bitsets of different sizes are compared as if the shorter one was padded
+ * with clear bits.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param a the first bitset.
+ * @param b the second bitset.
+ * 
+ * @return @c true if at least one bit is set in both @p a and @p b. Otherwise, @c false.
+ */
+bool csc_cbitset_intersects(const cbitset* a, const cbitset* b);
+
+/**
+ * @brief checks if every bit set in @p a is also set in @p b.
+ * 
+ * The scan stops at the first bit of @p a missing from @p b. Bitsets of different sizes are compared as if the
+ * shorter one was padded with clear bits.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param a the candidate subset.
+ * @param b the candidate superset.
+ * 
+ * @return @c true if @p a is a subset of @p b. Otherwise, @c false.
+ */
+bool csc_cbitset_is_subset(const cbitset* a, const cbitset* b);
+
+/**
+ * @brief returns the index of the lowest set bit.
+ * 
+ * Whole words are skipped while they are zero and the bit within a word is found with a count-trailing-zeros
+ * instruction.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) in the worst case, proportional to the number of words skipped.
+ * 
+ * @param b the bitset.
+ * 
+ * @return the index of the lowest set bit or the size of the bitset if no bit is set.
+ */
+size_t csc_cbitset_find_first(const cbitset* b);
+
+/**
+ * @brief returns the index of the lowest set bit at or after @p from.
+ * 
+ * See #csc_cbitset_find_first for more details. To visit every set bit, start with #csc_cbitset_find_first and
+ * continue with @c csc_cbitset_find_next(b, bit + 1).
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param from the first bit to consider.
+ * 
+ * @return the index of the bit or the size of the bitset if no bit at or after @p from is set.
+ */
+size_t csc_cbitset_find_next(const cbitset* b, size_t from);
+
+/**
+ * @brief returns the index of the lowest clear bit.
+ * 
+ * Whole words are skipped while all their bits are set, which makes this a fast "first free slot" lookup when the
+ * bitset tracks used slots.
+ * 
+ * @p b is expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) in the worst case, proportional to the number of words skipped.
+ * 
+ * @param b the bitset.
+ * 
+ * @return the index of the lowest clear bit or the size of the bitset if every bit is set.
+ */
+size_t csc_cbitset_find_first_zero(const cbitset* b);
+
+/**
+ * @brief returns the index of the lowest clear bit at or after @p from.
+ * 
+ * See #csc_cbitset_find_first_zero for more details.
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param from the first bit to consider.
+ * 
+ * @return the index of the bit or the size of the bitset if every bit at or after @p from is set.
+ */
+size_t csc_cbitset_find_next_zero(const cbitset* b, size_t from);
+
+/**
+ * @brief applies the callback function to the index of each set bit in ascending order.
+ * 
+ * Zero words are skipped and the set bits of a word are enumerated with a count-trailing-zeros instruction, so
+ * the cost depends on the number of words and set bits rather than the number of bits. The bitset must not be
+ * modified by the callback.
+ * 
+ * <b>Time Complexity:</b> @c O(n + k) where @c n is the number of words and @c k the number of set bits.
+ * 
+ * @param b the bitset. Must be @b non-null.
+ * @param fn the callback function. Must be @b non-null.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ * 
+ * @see csc_cbitset_iter
+ */
+void csc_cbitset_foreach(const cbitset* b, csc_bit_foreach fn, void* context);
+
+/**
+ * @brief an external iterator over the @b set bits of a #cbitset.
+ * 
+ * The iterator visits the indices of the set bits in ascending order. It skips whole zero words and finds the next
+ * set bit of a word with a count-trailing-zeros instruction, so sparse bitsets are iterated in time proportional to
+ * the number of words plus the number of set bits. The iterator is invalidated if the bitset is modified.
+ * 
+ * @code
+ * for (csc_cbitset_iter it = csc_cbitset_iter_begin(b); csc_cbitset_iter_valid(&it); csc_cbitset_iter_next(&it)) {
+ *      size_t bit = csc_cbitset_iter_get(&it);
+ *      if (bit > 100) {
+ *          break; // early exit
+ *      }
+ * }
+ * @endcode
+ * 
+ * The members are private and should not be accessed directly.
+ * 
+ */
+typedef struct csc_cbitset_iter {
+    const cbitset_word* words; /**< The words of the bitset. */
+    size_t nwords; /**< The number of words. */
+    size_t word; /**< The index of the current word. */
+    cbitset_word rest; /**< The bits of the current word that haven't been visited yet, including the current bit. */
+    size_t bit; /**< The index of the current set bit. */
+} csc_cbitset_iter;
+
+/**
+ * @brief returns an iterator positioned at the lowest set bit of the bitset.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) in the worst case to skip leading zero words.
+ * 
+ * @param b the bitset.
+ * 
+ * @return the iterator. If no bits are set, the iterator is not valid.
+ * 
+ * @see csc_cbitset_iter_valid
+ */
+csc_cbitset_iter csc_cbitset_iter_begin(const cbitset* b);
+
+/**
+ * @brief checks if the iterator refers to a set bit.
+ * 
+ * @param it the iterator.
+ * 
+ * @return @c true if the iterator refers to a set bit. @c false once the iteration is done.
+ */
+static inline bool csc_cbitset_iter_valid(const csc_cbitset_iter* it)
+{
+    return it->rest != 0;
+}
+
+/**
+ * @brief returns the index of the set bit the iterator refers to.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * @param it the iterator.
+ * 
+ * @return the index of the bit.
+ */
+static inline size_t csc_cbitset_iter_get(const csc_cbitset_iter* it)
+{
+    return it->bit;
+}
+
+/**
+ * @brief advances the iterator to the next set bit.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * <b>Time Complexity:</b> @c O(1) amortized over the words of the bitset.
+ * 
+ * @param it the iterator.
+ */
+static inline void csc_cbitset_iter_next(csc_cbitset_iter* it)
+{
+    // clear the lowest set bit and move on to the next non-zero word if this one is exhausted.
+    it->rest &= it->rest - 1;
+    while (it->rest == 0) {
+        if (++it->word >= it->nwords) {
+            return;
+        }
+        it->rest = it->words[it->word];
+    }
+    it->bit = (it->word * 8 * sizeof(cbitset_word)) + csc_ctz64(it->rest);
+}
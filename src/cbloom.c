@@ -0,0 +1,366 @@
+/**
+ * @file cbloom.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #cbloom data structure.
+ *
+ * @see cbloom.h
+ *
+ */
+
+#include "cbloom.h"
+#include "cbitset.h"
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#define CSC_BITSIZE ((sizeof(cbitset_word)) * (8))
+
+// a block of a blocked filter is one cache line.
+#define CSC_BLOCK_BYTES 64
+#define CSC_BLOCK_BITS (CSC_BLOCK_BYTES * 8)
+#define CSC_BLOCK_WORDS (CSC_BLOCK_BYTES / sizeof(cbitset_word))
+
+// the most bits probed per key. 64 probes already give a false positive rate of about 2^-64.
+#define CSC_MAX_HASHES 64
+
+struct cbloom {
+    cbitset* bits;        /**< The storage of the filter. */
+    cbitset_word* words;  /**< The first word of the filter within @c cbloom#bits. Cache line aligned if blocked. */
+    size_t offset;        /**< The number of words of @c cbloom#bits skipped to align @c cbloom#words. */
+    size_t nbits;         /**< The number of bits in the filter. */
+    size_t nblocks;       /**< The number of cache line blocks if blocked, 0 otherwise. */
+    size_t k;             /**< The number of bits probed per key. */
+    csc_allocator allocator; /**< The allocator used for the filter. */
+};
+
+/**
+ * @brief the header written in front of a serialized #cbloom.
+ *
+ */
+typedef struct _bloom_header {
+    char magic[8]; /**< Always #CSC_BLOOM_MAGIC. */
+    uint32_t version; /**< The layout version. Always #CSC_BLOOM_VERSION. */
+    uint32_t word_size; /**< The size of a #cbitset_word in bytes. */
+    uint64_t nbits; /**< The number of bits in the filter. */
+    uint32_t hashes; /**< The number of bits probed per key. */
+    uint32_t blocked; /**< 1 for a blocked filter, 0 otherwise. */
+} _bloom_header;
+
+#define CSC_BLOOM_MAGIC "CSCBLM\0"
+#define CSC_BLOOM_VERSION 1
+
+// the 64 bit finalizer of MurmurHash3. Every input bit affects every output bit.
+static uint64_t _mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// hashes the key 8 bytes at a time.
+static uint64_t _hash(const void* key, size_t len)
+{
+    const unsigned char* p = key;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ len;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ _mix(w)) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    uint64_t w = 0;
+    if (len != 0) {
+        memcpy(&w, p, len);
+    }
+    return _mix(h ^ w);
+}
+
+static bool _is_prime(size_t n)
+{
+    if (n < 2) {
+        return false;
+    }
+    if (n % 2 == 0) {
+        return n == 2;
+    }
+    for (size_t d = 3; d <= n / d; d += 2) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// returns the distance between the probes of a non-blocked filter. It is never 0, so with a prime number of bits
+// the k probes of a key are always k distinct bits.
+static size_t _step(const cbloom* f, uint64_t h2)
+{
+    return f->nbits > 1 ? 1 + (size_t)(h2 % (f->nbits - 1)) : 0;
+}
+
+// returns the number of words holding the bits of a filter with nbits.
+static size_t _words_for(size_t nbits)
+{
+    return (nbits / CSC_BITSIZE) + ((nbits % CSC_BITSIZE) != 0 ? 1 : 0);
+}
+
+static cbloom* _create(size_t nbits, size_t k, bool blocked, const csc_allocator* allocator)
+{
+    cbloom* f = allocator->alloc(sizeof(cbloom), allocator->context);
+    if (f == NULL) {
+        return NULL;
+    }
+
+    // a blocked filter reserves enough extra words to start its first block on a cache line boundary.
+    const size_t padding = blocked ? CSC_BLOCK_BITS - CSC_BITSIZE : 0;
+    f->bits = csc_cbitset_create_with_allocator(nbits + padding, allocator);
+    if (f->bits == NULL) {
+        allocator->free(f, sizeof(cbloom), allocator->context);
+        return NULL;
+    }
+
+    cbitset_word* words = csc_cbitset_words(f->bits);
+    f->offset = 0;
+    if (blocked) {
+        const size_t misalignment = (uintptr_t)words % CSC_BLOCK_BYTES;
+        f->offset = ((CSC_BLOCK_BYTES - misalignment) % CSC_BLOCK_BYTES) / sizeof(cbitset_word);
+    }
+    f->words = words + f->offset;
+    f->nbits = nbits;
+    f->nblocks = blocked ? nbits / CSC_BLOCK_BITS : 0;
+    f->k = k;
+    f->allocator = *allocator;
+
+    return f;
+}
+
+cbloom* csc_cbloom_create(size_t expected_items, double fp_rate)
+{
+    return csc_cbloom_create_with_allocator(expected_items, fp_rate, false, csc_default_allocator());
+}
+
+cbloom* csc_cbloom_create_blocked(size_t expected_items, double fp_rate)
+{
+    return csc_cbloom_create_with_allocator(expected_items, fp_rate, true, csc_default_allocator());
+}
+
+cbloom* csc_cbloom_create_with_allocator(size_t expected_items, double fp_rate, bool blocked,
+                                         const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    if (expected_items == 0 || !(fp_rate > 0.0 && fp_rate < 1.0)) {
+        return NULL;
+    }
+
+    // the textbook optimum: m = -n ln(p) / ln(2)^2 bits and k = (m / n) ln(2) hash functions.
+    const double ln2 = 0.69314718055994530942;
+    const double m = ceil(-(double)expected_items * log(fp_rate) / (ln2 * ln2));
+    if (m > (double)(SIZE_MAX / 2)) {
+        return NULL;
+    }
+
+    size_t nbits = (size_t)m;
+    if (blocked) {
+        nbits = ((nbits + CSC_BLOCK_BITS - 1) / CSC_BLOCK_BITS) * CSC_BLOCK_BITS;
+    } else {
+        // no probe step then shares a factor with nbits, so the probes don't cycle before k bits.
+        while (!_is_prime(nbits)) {
+            ++nbits;
+        }
+    }
+    const double k = floor((m / (double)expected_items) * ln2 + 0.5);
+
+    const size_t hashes = k < 1.0 ? 1 : k > CSC_MAX_HASHES ? CSC_MAX_HASHES : (size_t)k;
+    return _create(nbits, hashes, blocked, allocator);
+}
+
+void csc_cbloom_destroy(cbloom* f)
+{
+    assert(f != NULL);
+    const csc_allocator a = f->allocator;
+    csc_cbitset_destroy(f->bits);
+    a.free(f, sizeof(cbloom), a.context);
+}
+
+void csc_cbloom_add_hash(cbloom* f, uint64_t hash)
+{
+    assert(f != NULL);
+
+    // double hashing: the i-th probe is h1 + i * h2, so a single hash yields every probe.
+    const uint64_t h2 = _mix(hash ^ 0x9e3779b97f4a7c15ULL);
+    if (f->nblocks != 0) {
+        cbitset_word* block = f->words + ((hash % f->nblocks) * CSC_BLOCK_WORDS);
+        const uint64_t step = (h2 >> 32) | 1;
+        uint64_t pos = h2;
+        for (size_t i = 0; i < f->k; ++i, pos += step) {
+            const size_t bit = (size_t)(pos % CSC_BLOCK_BITS);
+            block[bit / CSC_BITSIZE] |= (cbitset_word)1 << (bit % CSC_BITSIZE);
+        }
+        return;
+    }
+
+    const size_t step = _step(f, h2);
+    size_t bit = (size_t)(hash % f->nbits);
+    for (size_t i = 0; i < f->k; ++i) {
+        f->words[bit / CSC_BITSIZE] |= (cbitset_word)1 << (bit % CSC_BITSIZE);
+        bit += step;
+        if (bit >= f->nbits) {
+            bit -= f->nbits;
+        }
+    }
+}
+
+bool csc_cbloom_maybe_contains_hash(const cbloom* f, uint64_t hash)
+{
+    assert(f != NULL);
+
+    // the probes must match csc_cbloom_add_hash exactly.
+    const uint64_t h2 = _mix(hash ^ 0x9e3779b97f4a7c15ULL);
+    if (f->nblocks != 0) {
+        const cbitset_word* block = f->words + ((hash % f->nblocks) * CSC_BLOCK_WORDS);
+        const uint64_t step = (h2 >> 32) | 1;
+        uint64_t pos = h2;
+        for (size_t i = 0; i < f->k; ++i, pos += step) {
+            const size_t bit = (size_t)(pos % CSC_BLOCK_BITS);
+            if ((block[bit / CSC_BITSIZE] & ((cbitset_word)1 << (bit % CSC_BITSIZE))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const size_t step = _step(f, h2);
+    size_t bit = (size_t)(hash % f->nbits);
+    for (size_t i = 0; i < f->k; ++i) {
+        if ((f->words[bit / CSC_BITSIZE] & ((cbitset_word)1 << (bit % CSC_BITSIZE))) == 0) {
+            return false;
+        }
+        bit += step;
+        if (bit >= f->nbits) {
+            bit -= f->nbits;
+        }
+    }
+    return true;
+}
+
+void csc_cbloom_add(cbloom* f, const void* key, size_t len)
+{
+    assert(key != NULL || len == 0);
+    csc_cbloom_add_hash(f, _hash(key, len));
+}
+
+bool csc_cbloom_maybe_contains(const cbloom* f, const void* key, size_t len)
+{
+    assert(key != NULL || len == 0);
+    return csc_cbloom_maybe_contains_hash(f, _hash(key, len));
+}
+
+CSCError csc_cbloom_union(cbloom* dst, const cbloom* src)
+{
+    assert(dst != NULL && src != NULL);
+    if (dst->nbits != src->nbits || dst->k != src->k || dst->nblocks != src->nblocks) {
+        return E_INVALIDOPERATION;
+    }
+
+    // with the same alignment the bitsets line up and the vectorized bitset union applies.
+    if (dst->offset == src->offset) {
+        return csc_cbitset_or(dst->bits, src->bits);
+    }
+
+    const size_t n = _words_for(dst->nbits);
+    for (size_t i = 0; i < n; ++i) {
+        dst->words[i] |= src->words[i];
+    }
+    return E_NOERR;
+}
+
+void csc_cbloom_clear(cbloom* f)
+{
+    assert(f != NULL);
+    csc_cbitset_clear_all(f->bits);
+}
+
+size_t csc_cbloom_bits(const cbloom* f)
+{
+    assert(f != NULL);
+    return f->nbits;
+}
+
+size_t csc_cbloom_hashes(const cbloom* f)
+{
+    assert(f != NULL);
+    return f->k;
+}
+
+size_t csc_cbloom_serialized_size(const cbloom* f)
+{
+    assert(f != NULL);
+    return sizeof(_bloom_header) + (_words_for(f->nbits) * sizeof(cbitset_word));
+}
+
+CSCError csc_cbloom_serialize(const cbloom* f, void* buf, size_t len)
+{
+    assert(f != NULL && buf != NULL);
+    if (len < csc_cbloom_serialized_size(f)) {
+        return E_OUTOFRANGE;
+    }
+
+    _bloom_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CSC_BLOOM_MAGIC, sizeof(h.magic));
+    h.version = CSC_BLOOM_VERSION;
+    h.word_size = sizeof(cbitset_word);
+    h.nbits = f->nbits;
+    h.hashes = (uint32_t)f->k;
+    h.blocked = f->nblocks != 0 ? 1 : 0;
+
+    char* out = buf;
+    memcpy(out, &h, sizeof(h));
+    memcpy(out + sizeof(h), f->words, _words_for(f->nbits) * sizeof(cbitset_word));
+
+    return E_NOERR;
+}
+
+cbloom* csc_cbloom_deserialize(const void* buf, size_t len, CSCError* e)
+{
+    assert(buf != NULL);
+    CSCError err = E_INVALIDOPERATION;
+    cbloom* f = NULL;
+
+    // the buffer may not be aligned, so the header is copied out before it is read.
+    _bloom_header h;
+    if (len >= sizeof(h)) {
+        memcpy(&h, buf, sizeof(h));
+    }
+    const size_t max_words = len >= sizeof(h) ? (len - sizeof(h)) / sizeof(cbitset_word) : 0;
+    const bool valid = len >= sizeof(h) && memcmp(h.magic, CSC_BLOOM_MAGIC, sizeof(h.magic)) == 0
+        && h.version == CSC_BLOOM_VERSION && h.word_size == sizeof(cbitset_word) && h.hashes != 0
+        && h.hashes <= CSC_MAX_HASHES && h.hashes <= h.nbits
+        && h.blocked <= 1 && h.nbits != 0 && h.nbits / CSC_BITSIZE <= max_words
+        && _words_for((size_t)h.nbits) <= max_words && (h.blocked == 0 || h.nbits % CSC_BLOCK_BITS == 0);
+
+    if (valid) {
+        f = _create((size_t)h.nbits, h.hashes, h.blocked != 0, csc_default_allocator());
+        err = E_OUTOFMEM;
+    }
+    if (f != NULL) {
+        const size_t n = _words_for(f->nbits);
+        memcpy(f->words, (const char*)buf + sizeof(h), n * sizeof(cbitset_word));
+
+        // keep the bits past the end of the filter cleared, as the bitset expects.
+        const size_t tail = f->nbits % CSC_BITSIZE;
+        if (tail != 0) {
+            f->words[n - 1] &= ((cbitset_word)1 << tail) - 1;
+        }
+        err = E_NOERR;
+    }
+
+    if (e != NULL) {
+        *e = err;
+    }
+    return f;
+}
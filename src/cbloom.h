@@ -0,0 +1,250 @@
+#pragma once
+
+/**
+ * @file cbloom.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #cbloom data structure.
+ *
+ * A Bloom filter answers "have I seen this key?" in constant time and a few bits per key. It never reports a key
+ * that was added as missing, but it may report a key that was never added as present. The chance of such a false
+ * positive is chosen when the filter is created.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // size the filter for 1 million keys with a 1% false positive rate
+ * cbloom* f = csc_cbloom_create(1000000, 0.01);
+ * if (f == NULL) {
+ *      // couldn't create the filter
+ * }
+ *
+ * const char* key = "hello";
+ * csc_cbloom_add(f, key, strlen(key));
+ *
+ * if (!csc_cbloom_maybe_contains(f, key, strlen(key))) {
+ *      // can't happen
+ * }
+ *
+ * if (csc_cbloom_maybe_contains(f, "world", 5)) {
+ *      // a false positive. do the slow lookup to find out for sure.
+ * }
+ *
+ * csc_cbloom_destroy(f);
+ * @endcode
+ *
+ * The bits are stored in a #cbitset. Each key is hashed once and the bit positions are derived from that hash by
+ * double hashing, so the cost of a query is one hash and one memory access per bit probed. A standard filter rounds
+ * its number of bits up to a prime so that every key probes distinct bits.
+ *
+ * A blocked filter, created with #csc_cbloom_create_blocked, places every bit of a key in the same 64 byte cache
+ * line. Queries then cost at most one cache miss, at the price of a slightly higher false positive rate than a
+ * standard filter of the same size.
+ *
+ * @see cbitset.h
+ *
+ */
+
+#include "csc.h"
+
+/**
+ * @brief the cbloom data structure.
+ *
+ */
+typedef struct cbloom cbloom;
+
+/**
+ * @brief creates a #cbloom.
+ *
+ * The number of bits and hash functions are chosen so that the filter has a false positive rate of @p fp_rate once
+ * @p expected_items keys have been added. Adding more keys raises the false positive rate.
+ *
+ * @param expected_items the number of keys the filter is sized for. Must be greater than 0.
+ * @param fp_rate the false positive rate. Must be greater than 0 and less than 1.
+ *
+ * @return a pointer to a #cbloom if successful. On failure or if a parameter is out of range, @c NULL is returned.
+ *
+ * @see csc_cbloom_destroy
+ *
+ */
+cbloom* csc_cbloom_create(size_t expected_items, double fp_rate);
+
+/**
+ * @brief creates a blocked #cbloom.
+ *
+ * This function is identical to #csc_cbloom_create except that the bits of each key are kept within a single
+ * cache line. See the file documentation for more details.
+ *
+ * @param expected_items the number of keys the filter is sized for. Must be greater than 0.
+ * @param fp_rate the false positive rate. Must be greater than 0 and less than 1.
+ *
+ * @return a pointer to a #cbloom if successful. On failure or if a parameter is out of range, @c NULL is returned.
+ *
+ * @see csc_cbloom_destroy
+ *
+ */
+cbloom* csc_cbloom_create_blocked(size_t expected_items, double fp_rate);
+
+/**
+ * @brief creates a #cbloom using a custom allocator.
+ *
+ * This function is identical to #csc_cbloom_create, or #csc_cbloom_create_blocked if @p blocked is @c true, except
+ * that the filter is allocated through @p allocator.
+ *
+ * @param expected_items the number of keys the filter is sized for. Must be greater than 0.
+ * @param fp_rate the false positive rate. Must be greater than 0 and less than 1.
+ * @param blocked if @c true, a blocked filter is created.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a #cbloom if successful. On failure or if a parameter is out of range, @c NULL is returned.
+ *
+ * @see csc_cbloom_destroy
+ *
+ */
+cbloom* csc_cbloom_create_with_allocator(size_t expected_items, double fp_rate, bool blocked,
+                                         const csc_allocator* allocator);
+
+/**
+ * @brief destroys a #cbloom.
+ *
+ * @param f the filter to destroy. Must be @b non-null.
+ *
+ */
+void csc_cbloom_destroy(cbloom* f);
+
+/**
+ * @brief adds a key to the filter.
+ *
+ * <b>Time Complexity:</b> @c O(len + k) where @c k is the number of hash functions.
+ *
+ * @param f the filter. Must be @b non-null.
+ * @param key the bytes of the key. Can only be @c NULL if @p len is 0.
+ * @param len the length of the key in bytes.
+ *
+ */
+void csc_cbloom_add(cbloom* f, const void* key, size_t len);
+
+/**
+ * @brief determines if a key may have been added to the filter.
+ *
+ * <b>Time Complexity:</b> @c O(len + k) where @c k is the number of hash functions.
+ *
+ * @param f the filter. Must be @b non-null.
+ * @param key the bytes of the key. Can only be @c NULL if @p len is 0.
+ * @param len the length of the key in bytes.
+ *
+ * @return @c false if the key was definitely not added. @c true if it was added or on a false positive.
+ */
+bool csc_cbloom_maybe_contains(const cbloom* f, const void* key, size_t len);
+
+/**
+ * @brief adds a key that was already hashed to the filter.
+ *
+ * Use this when the keys already carry a good 64 bit hash. Keys added this way must be queried with
+ * #csc_cbloom_maybe_contains_hash.
+ *
+ * <b>Time Complexity:</b> @c O(k) where @c k is the number of hash functions.
+ *
+ * @param f the filter. Must be @b non-null.
+ * @param hash the hash of the key.
+ *
+ */
+void csc_cbloom_add_hash(cbloom* f, uint64_t hash);
+
+/**
+ * @brief determines if a key with the given hash may have been added to the filter.
+ *
+ * <b>Time Complexity:</b> @c O(k) where @c k is the number of hash functions.
+ *
+ * @param f the filter. Must be @b non-null.
+ * @param hash the hash of the key.
+ *
+ * @return @c false if the key was definitely not added. @c true if it was added or on a false positive.
+ *
+ * @see csc_cbloom_add_hash
+ */
+bool csc_cbloom_maybe_contains_hash(const cbloom* f, uint64_t hash);
+
+/**
+ * @brief adds every key of @p src to @p dst.
+ *
+ * Afterwards, @p dst reports every key that was added to either filter. Both filters must have been created with
+ * the same parameters.
+ *
+ * <b>Time Complexity:</b> @c O(m) where @c m is the number of bits.
+ *
+ * @param dst the filter to add to. Must be @b non-null.
+ * @param src the filter to add. Must be @b non-null.
+ *
+ * @return On success, @c CSCError#E_NOERR. If the filters differ in size, number of hash functions or layout,
+ * @c CSCError#E_INVALIDOPERATION.
+ */
+CSCError csc_cbloom_union(cbloom* dst, const cbloom* src);
+
+/**
+ * @brief removes every key from the filter.
+ *
+ * @param f the filter. Must be @b non-null.
+ *
+ */
+void csc_cbloom_clear(cbloom* f);
+
+/**
+ * @brief returns the number of bits in the filter.
+ *
+ * @param f the filter. Must be @b non-null.
+ *
+ * @return the number of bits.
+ */
+size_t csc_cbloom_bits(const cbloom* f);
+
+/**
+ * @brief returns the number of bits probed per key.
+ *
+ * This is never more than 64.
+ *
+ * @param f the filter. Must be @b non-null.
+ *
+ * @return the number of hash functions.
+ */
+size_t csc_cbloom_hashes(const cbloom* f);
+
+/**
+ * @brief returns the number of bytes #csc_cbloom_serialize writes.
+ *
+ * @param f the filter. Must be @b non-null.
+ *
+ * @return the size of the serialized filter in bytes.
+ */
+size_t csc_cbloom_serialized_size(const cbloom* f);
+
+/**
+ * @brief writes the filter to a buffer.
+ *
+ * The buffer holds a small header followed by the words of the filter in native byte order, so it can be read back
+ * by #csc_cbloom_deserialize on a machine with the same word size and byte order.
+ *
+ * @param f the filter. Must be @b non-null.
+ * @param buf the buffer to write to. Must be @b non-null.
+ * @param len the size of @p buf in bytes.
+ *
+ * @return On success, @c CSCError#E_NOERR. If @p len is smaller than #csc_cbloom_serialized_size,
+ * @c CSCError#E_OUTOFRANGE.
+ */
+CSCError csc_cbloom_serialize(const cbloom* f, void* buf, size_t len);
+
+/**
+ * @brief creates a #cbloom from a buffer written by #csc_cbloom_serialize.
+ *
+ * @param buf the buffer to read. Must be @b non-null.
+ * @param len the size of @p buf in bytes.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ *
+ * @return a pointer to a #cbloom if successful and @c NULL otherwise. On success, @p e is @c CSCError#E_NOERR. If
+ * the buffer doesn't hold a serialized filter, including one claiming more than 64 hash functions or more hash
+ * functions than bits, @p e is @c CSCError#E_INVALIDOPERATION. If memory couldn't be
+ * allocated, @p e is @c CSCError#E_OUTOFMEM.
+ *
+ * @see csc_cbloom_destroy
+ */
+cbloom* csc_cbloom_deserialize(const void* buf, size_t len, CSCError* e);
@@ -8,70 +8,88 @@
 
 #include "cbst.h"
 #include <assert.h>
+#include <string.h>
 
 typedef struct _node {
     void* data;
     struct _node* left;
     struct _node* right;
+    struct _node* parent;
+    bool red; /**< The color of the node. Missing children count as black. */
 } _node;
 
 struct cbst {
     _node* root;
     size_t size;
+    csc_allocator allocator; /**< The allocator used for the tree and its nodes. */
 };
 
-static _node* _create_node(void* data)
+static _node* _create_node(const csc_allocator* a, void* data, _node* parent)
 {
-    _node* n = calloc(1, sizeof(*n));
+    _node* n = a->alloc(sizeof(*n), a->context);
     if (n != NULL) {
+        memset(n, 0, sizeof(*n));
         n->data = data;
+        n->parent = parent;
+        n->red = true;
     }
     return n;
 }
 
-// TODO: turn into iterative traversal
-static void _inorder_traversal(_node* n, csc_foreach fn, void* context)
+static void _free_node(const csc_allocator* a, _node* n)
 {
-    if (n != NULL) {
-        _inorder_traversal(n->left, fn, context);
-        fn(n->data, context);
-        _inorder_traversal(n->right, fn, context);
-    }
+    a->free(n, sizeof(*n), a->context);
 }
 
-// TODO: turn into iterative traversal
-static void _free_cbst(_node* n)
+static bool _is_red(const _node* n)
 {
-    if (n != NULL) {
-        _free_cbst(n->left);
-        _free_cbst(n->right);
-        free(n);
+    return n != NULL && n->red;
+}
+
+static _node* _leftmost(_node* n)
+{
+    while (n != NULL && n->left != NULL) {
+        n = n->left;
     }
+    return n;
 }
 
-static CSCError _add_cbst(_node** n, void* elem, csc_compare cmp, size_t* size)
+// returns the in-order successor of the node using the parent links.
+static _node* _successor(_node* n)
 {
-    if (*n == NULL) {
-        *n = _create_node(elem);
-        if (*n == NULL) {
-            return E_OUTOFMEM;
-        }
-        ++*size;
-        return E_NOERR;
+    if (n->right != NULL) {
+        return _leftmost(n->right);
     }
 
-    _node* w = *n;
-    while (true) {
-        const int result = cmp(elem, w->data);
-        if (result < 0) {
-            return _add_cbst(&(w->left), elem, cmp, size);
-        } else if (result > 0) {
-            return _add_cbst(&(w->right), elem, cmp, size);
+    _node* p = n->parent;
+    while (p != NULL && n == p->right) {
+        n = p;
+        p = p->parent;
+    }
+    return p;
+}
+
+static void _free_cbst(const csc_allocator* a, _node* n)
+{
+    // free the tree bottom up without recursion by walking down to a leaf, freeing it and resuming from its parent.
+    while (n != NULL) {
+        if (n->left != NULL) {
+            n = n->left;
+        } else if (n->right != NULL) {
+            n = n->right;
         } else {
-            return E_INVALIDOPERATION;
+            _node* p = n->parent;
+            if (p != NULL) {
+                if (p->left == n) {
+                    p->left = NULL;
+                } else {
+                    p->right = NULL;
+                }
+            }
+            _free_node(a, n);
+            n = p;
         }
     }
-    return E_NOERR;
 }
 
 static _node* _find_cbst(const cbst* b, const void* elem, csc_compare cmp)
@@ -95,24 +113,205 @@ static _node* _find_cbst(const cbst* b, const void* elem, csc_compare cmp)
     return NULL;
 }
 
-static _node* _leftmost(_node* n)
+// replaces the subtree rooted at u with the subtree rooted at v.
+static void _transplant(cbst* b, _node* u, _node* v)
 {
-    while (n != NULL && n->left != NULL) {
-        n = n->left;
+    if (u->parent == NULL) {
+        b->root = v;
+    } else if (u == u->parent->left) {
+        u->parent->left = v;
+    } else {
+        u->parent->right = v;
     }
-    return n;
+    if (v != NULL) {
+        v->parent = u->parent;
+    }
+}
+
+// rotates the right child of x into x's position.
+static void _rotate_left(cbst* b, _node* x)
+{
+    _node* y = x->right;
+    x->right = y->left;
+    if (y->left != NULL) {
+        y->left->parent = x;
+    }
+    _transplant(b, x, y);
+    y->left = x;
+    x->parent = y;
+}
+
+// rotates the left child of x into x's position.
+static void _rotate_right(cbst* b, _node* x)
+{
+    _node* y = x->left;
+    x->left = y->right;
+    if (y->right != NULL) {
+        y->right->parent = x;
+    }
+    _transplant(b, x, y);
+    y->right = x;
+    x->parent = y;
+}
+
+// restores the red-black properties after the red node n was inserted.
+static void _add_fixup(cbst* b, _node* n)
+{
+    while (_is_red(n->parent)) {
+        // the parent is red so it isn't the root and the grandparent exists.
+        _node* p = n->parent;
+        _node* g = p->parent;
+        if (p == g->left) {
+            _node* uncle = g->right;
+            if (_is_red(uncle)) { // recolor and continue from the grandparent
+                p->red = false;
+                uncle->red = false;
+                g->red = true;
+                n = g;
+            } else {
+                if (n == p->right) { // rotate the inner case into the outer case
+                    _rotate_left(b, p);
+                    n = p;
+                    p = n->parent;
+                }
+                p->red = false;
+                g->red = true;
+                _rotate_right(b, g);
+            }
+        } else {
+            _node* uncle = g->left;
+            if (_is_red(uncle)) {
+                p->red = false;
+                uncle->red = false;
+                g->red = true;
+                n = g;
+            } else {
+                if (n == p->left) {
+                    _rotate_right(b, p);
+                    n = p;
+                    p = n->parent;
+                }
+                p->red = false;
+                g->red = true;
+                _rotate_left(b, g);
+            }
+        }
+    }
+    b->root->red = false;
+}
+
+// restores the red-black properties after a black node was removed. x took the removed node's place
+// and is missing a black node on its path. x may be NULL so its parent is passed separately.
+static void _rm_fixup(cbst* b, _node* x, _node* parent)
+{
+    while (x != b->root && !_is_red(x)) {
+        if (x == parent->left) {
+            // the sibling exists since its side of the tree has more black nodes.
+            _node* w = parent->right;
+            if (w->red) { // make the sibling black
+                w->red = false;
+                parent->red = true;
+                _rotate_left(b, parent);
+                w = parent->right;
+            }
+            if (!_is_red(w->left) && !_is_red(w->right)) { // move the missing black node up
+                w->red = true;
+                x = parent;
+                parent = x->parent;
+            } else {
+                if (!_is_red(w->right)) { // make the far child of the sibling red
+                    w->left->red = false;
+                    w->red = true;
+                    _rotate_right(b, w);
+                    w = parent->right;
+                }
+                w->red = parent->red;
+                parent->red = false;
+                w->right->red = false;
+                _rotate_left(b, parent);
+                x = b->root;
+            }
+        } else {
+            _node* w = parent->left;
+            if (w->red) {
+                w->red = false;
+                parent->red = true;
+                _rotate_right(b, parent);
+                w = parent->left;
+            }
+            if (!_is_red(w->left) && !_is_red(w->right)) {
+                w->red = true;
+                x = parent;
+                parent = x->parent;
+            } else {
+                if (!_is_red(w->left)) {
+                    w->right->red = false;
+                    w->red = true;
+                    _rotate_left(b, w);
+                    w = parent->left;
+                }
+                w->red = parent->red;
+                parent->red = false;
+                w->left->red = false;
+                _rotate_right(b, parent);
+                x = b->root;
+            }
+        }
+    }
+    if (x != NULL) {
+        x->red = false;
+    }
+}
+
+static CSCError _add_cbst(cbst* b, void* elem, csc_compare cmp)
+{
+    _node* parent = NULL;
+    _node** link = &(b->root);
+    while (*link != NULL) {
+        parent = *link;
+        const int result = cmp(elem, parent->data);
+        if (result < 0) {
+            link = &(parent->left);
+        } else if (result > 0) {
+            link = &(parent->right);
+        } else {
+            return E_INVALIDOPERATION;
+        }
+    }
+
+    _node* n = _create_node(&(b->allocator), elem, parent);
+    if (n == NULL) {
+        return E_OUTOFMEM;
+    }
+    *link = n;
+    _add_fixup(b, n);
+    ++b->size;
+
+    return E_NOERR;
 }
 
 cbst* csc_cbst_create()
 {
-    return calloc(1, sizeof(cbst));
+    return csc_cbst_create_with_allocator(csc_default_allocator());
+}
+
+cbst* csc_cbst_create_with_allocator(const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    cbst* b = allocator->alloc(sizeof(cbst), allocator->context);
+    if (b != NULL) {
+        memset(b, 0, sizeof(*b));
+        b->allocator = *allocator;
+    }
+    return b;
 }
 
 void csc_cbst_destroy(cbst* b)
 {
     assert(b != NULL);
-    _free_cbst(b->root);
-    free(b);
+    const csc_allocator a = b->allocator;
+    _free_cbst(&a, b->root);
+    a.free(b, sizeof(*b), a.context);
 }
 
 CSCError csc_cbst_add(cbst* b, void* elem, csc_compare cmp)
@@ -121,7 +320,7 @@ CSCError csc_cbst_add(cbst* b, void* elem, csc_compare cmp)
     if (elem == NULL) {
         return E_INVALIDOPERATION;
     }
-    return _add_cbst(&(b->root), elem, cmp, &(b->size));
+    return _add_cbst(b, elem, cmp);
 }
 
 void* csc_cbst_rm(cbst* b, const void* elem, csc_compare cmp)
@@ -131,34 +330,45 @@ void* csc_cbst_rm(cbst* b, const void* elem, csc_compare cmp)
     if (n == NULL) {
         return NULL;
     }
-    
-   if (n->left == NULL && n->right == NULL) { // no children
-        void* data = n->data;
-        free(n); // TODO: does parent of n know it is now NULL?
-        --b->size;
-        return data;
-    } else if (n->right == NULL && n->left != NULL) { // only left child
-        void* data = n->data;
-        csc_swap(&(n->data), &(n->left->data));
-        free(n->left);
-        --b->size;
-        n->left = NULL;
-        return data;
-    } else if (n->left == NULL && n->right != NULL) { // only right child
-        void* data = n->data;
-        csc_swap(&(n->data), &(n->right->data));
-        free(n->right);
-        --b->size;
-        n->right = NULL;
-        return data;
-    } else { // both children
-        void* data = n->data;
-        _node* left = _leftmost(n->right);
-        csc_swap(&(left->data), &(n->data));
-        --b->size;
-        free(left); // TODO: does parent of left know it is now NULL?
-        return data;
+
+    // x is the node that moves into the position of the node taken out of the tree, which is n itself
+    // unless n has two children, in which case it is n's successor.
+    bool removed_red = n->red;
+    _node* x = NULL;
+    _node* x_parent = NULL;
+    if (n->left == NULL) { // at most a right child
+        x = n->right;
+        x_parent = n->parent;
+        _transplant(b, n, n->right);
+    } else if (n->right == NULL) { // only left child
+        x = n->left;
+        x_parent = n->parent;
+        _transplant(b, n, n->left);
+    } else { // both children: replace the node with its successor
+        _node* s = _leftmost(n->right);
+        removed_red = s->red;
+        x = s->right;
+        x_parent = s;
+        if (s->parent != n) {
+            x_parent = s->parent;
+            _transplant(b, s, s->right);
+            s->right = n->right;
+            s->right->parent = s;
+        }
+        _transplant(b, n, s);
+        s->left = n->left;
+        s->left->parent = s;
+        s->red = n->red;
+    }
+    if (!removed_red) {
+        _rm_fixup(b, x, x_parent);
     }
+
+    void* data = n->data;
+    _free_node(&(b->allocator), n);
+    --b->size;
+
+    return data;
 }
 
 void* csc_cbst_find(const cbst* b, const void* elem, csc_compare cmp)
@@ -183,8 +393,48 @@ bool csc_cbst_empty(const cbst* b)
     return b->size == 0;
 }
 
+size_t csc_cbst_height(const cbst* b)
+{
+    assert(b != NULL);
+
+    // only leaves can end a longest path, so measure the depth of each leaf by following the parent links.
+    size_t height = 0;
+    for (_node* n = _leftmost(b->root); n != NULL; n = _successor(n)) {
+        if (n->left == NULL && n->right == NULL) {
+            size_t depth = 0;
+            for (const _node* p = n; p != NULL; p = p->parent) {
+                ++depth;
+            }
+            if (depth > height) {
+                height = depth;
+            }
+        }
+    }
+    return height;
+}
+
 void csc_cbst_foreach(cbst* b, csc_foreach fn, void* context)
 {
     assert(b != NULL);
-    _inorder_traversal(b->root, fn, context);
-}
\ No newline at end of file
+    for (_node* n = _leftmost(b->root); n != NULL; n = _successor(n)) {
+        fn(n->data, context);
+    }
+}
+
+csc_cbst_iter csc_cbst_iter_begin(const cbst* b)
+{
+    assert(b != NULL);
+    csc_cbst_iter it;
+    _node* n = _leftmost(b->root);
+    it.node = n;
+    it.data = n != NULL ? n->data : NULL;
+    return it;
+}
+
+void csc_cbst_iter_next(csc_cbst_iter* it)
+{
+    assert(it != NULL && it->node != NULL);
+    _node* n = _successor((_node*)it->node);
+    it->node = n;
+    it->data = n != NULL ? n->data : NULL;
+}
@@ -7,10 +7,13 @@
  * @brief This file defines the interface to the #cbst data structure.
  *
  * 
- * #cbst implements a standard binary search tree (BST). In this implementation,
+ * #cbst implements a binary search tree (BST). In this implementation,
  * attempting to add duplicate or @c NULL keys is not allowed. See #csc_bst_add
  * for more details.
  * 
+ * The tree is kept balanced as a red-black tree, so its height never exceeds @c 2*log2(n+1) even when elements
+ * are added in sorted order. Adding, removing and finding elements are iterative and use constant stack space.
+ * 
  * Here is a brief code sample to get you started with using #cbst:
  * 
  * @code
@@ -102,6 +105,21 @@ typedef struct cbst cbst;
  */
 cbst* csc_cbst_create();
 
+/**
+ * @brief cbst "constructor" function using a custom allocator.
+ * 
+ * This function is identical to #csc_cbst_create except that the tree and its nodes are allocated through
+ * @p allocator.
+ * 
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cbst or @c NULL on failure.
+ * 
+ * @see csc_cbst_destroy
+ * 
+ */
+cbst* csc_cbst_create_with_allocator(const csc_allocator* allocator);
+
 /**
  * @brief cbst "destructor" function
  * 
@@ -122,8 +140,7 @@ void csc_cbst_destroy(cbst* b);
  * 
  * Both @p elem and @p b are expected to be @b non-null. This means that @c NULL elements are @b not allowed.
  * 
- * <b>Time Complexity:</b> @c O(1) best case, @c O(h) worst case, @c O(log(n)) average case where @c h is the height
- * of the tree and @c n is the number of elements the tree holds.
+ * <b>Time Complexity:</b> @c O(log(n)) where @c n is the number of elements the tree holds.
  * 
  * @param b the BST.
  * @param elem the element to add.
@@ -143,8 +160,7 @@ CSCError csc_cbst_add(cbst* b, void* elem, csc_compare cmp);
  * 
  * All three parameters are expected to be @b non-null.
  * 
- * <b>Time Complexity:</b> @c O(1) best case, @c O(h) worst case, @c O(log(n)) average case where @c h is the height
- * of the tree and @c n is the number of elements the tree holds.
+ * <b>Time Complexity:</b> @c O(log(n)) where @c n is the number of elements the tree holds.
  * 
  * @param b the BST.
  * @param elem the element to remove.
@@ -165,8 +181,7 @@ void* csc_cbst_rm(cbst* b, const void* elem, csc_compare cmp);
  * 
  * All parameters are expected to be @b non-null.
  * 
- * <b>Time Complexity:</b> @c O(1) best case, @c O(h) worst case, @c O(log(n)) average case where @c h is the height
- * of the tree and @c n is the number of elements the tree holds.
+ * <b>Time Complexity:</b> @c O(log(n)) where @c n is the number of elements the tree holds.
  * 
  * @param b the BST.
  * @param elem the element to find.
@@ -202,6 +217,20 @@ size_t csc_cbst_size(const cbst* b);
  */
 bool csc_cbst_empty(const cbst* b);
 
+/**
+ * @brief returns the height of the BST.
+ * 
+ * The height is the number of nodes on the longest path from the root to a leaf. It is at most @c 2*log2(n+1).
+ * This is mainly useful for diagnostics.
+ * 
+ * <b>Time Complexity:</b> @c O(n*log(n))
+ * 
+ * @param b the BST. Must be @b non-null.
+ * 
+ * @return the height of the BST or 0 if it is empty.
+ */
+size_t csc_cbst_height(const cbst* b);
+
 /**
  * @brief applies the callback function to each element of the BST in an @b in-order traversal.
  * .
@@ -214,4 +243,80 @@ bool csc_cbst_empty(const cbst* b);
  * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
  * 
  */
-void csc_cbst_foreach(cbst* b, csc_foreach fn, void* context);
\ No newline at end of file
+void csc_cbst_foreach(cbst* b, csc_foreach fn, void* context);
+
+/**
+ * @brief an external iterator over the elements of a #cbst in @b in-order.
+ * 
+ * Unlike #csc_cbst_foreach, iterating with a #csc_cbst_iter doesn't require a callback, allows early termination and
+ * doesn't allocate memory. Each node links to its parent so advancing the iterator needs no stack. The iterator
+ * is invalidated if the tree is modified, except that removing an element other than the current one is allowed.
+ * 
+ * @code
+ * for (csc_cbst_iter it = csc_cbst_iter_begin(b); csc_cbst_iter_valid(&it); csc_cbst_iter_next(&it)) {
+ *      int* x = (int*) csc_cbst_iter_get(&it);
+ *      if (*x > 10) {
+ *          break; // early exit
+ *      }
+ * }
+ * @endcode
+ * 
+ * The members are private and should not be accessed directly.
+ * 
+ */
+typedef struct csc_cbst_iter {
+    void* node; /**< The current node or @c NULL once the iteration is done. */
+    void* data; /**< The element held by the current node. */
+} csc_cbst_iter;
+
+/**
+ * @brief returns an iterator positioned at the smallest element of the BST.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(h) where @c h is the height of the tree.
+ * 
+ * @param b the BST.
+ * 
+ * @return the iterator. If the tree is empty, the iterator is not valid.
+ * 
+ * @see csc_cbst_iter_valid
+ */
+csc_cbst_iter csc_cbst_iter_begin(const cbst* b);
+
+/**
+ * @brief advances the iterator to the next element in order.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * <b>Time Complexity:</b> @c O(1) amortized.
+ * 
+ * @param it the iterator.
+ */
+void csc_cbst_iter_next(csc_cbst_iter* it);
+
+/**
+ * @brief checks if the iterator refers to an element.
+ * 
+ * @param it the iterator.
+ * 
+ * @return @c true if the iterator refers to an element. @c false once the iteration is done.
+ */
+static inline bool csc_cbst_iter_valid(const csc_cbst_iter* it)
+{
+    return it->node != NULL;
+}
+
+/**
+ * @brief returns the element the iterator refers to.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * @param it the iterator.
+ * 
+ * @return the element.
+ */
+static inline void* csc_cbst_iter_get(const csc_cbst_iter* it)
+{
+    return it->data;
+}
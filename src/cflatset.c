@@ -0,0 +1,134 @@
+/**
+ * @file cflatset.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #cflatset data structure.
+ *
+ * @see cflatset.h
+ *
+ */
+
+#include "cflatset.h"
+#include "cvector.h"
+#include <assert.h>
+
+struct cflatset {
+    cvector* v; /**< The sorted elements of the set. */
+    csc_compare cmp; /**< The comparison function defining the order of the set. */
+    csc_allocator allocator; /**< The allocator used for the set. */
+};
+
+static cflatset* _create(cvector* v, csc_compare cmp, const csc_allocator* allocator)
+{
+    if (v == NULL) {
+        return NULL;
+    }
+
+    cflatset* s = allocator->alloc(sizeof(*s), allocator->context);
+    if (s == NULL) {
+        csc_cvector_destroy(v);
+        return NULL;
+    }
+    s->v = v;
+    s->cmp = cmp;
+    s->allocator = *allocator;
+
+    return s;
+}
+
+cflatset* csc_cflatset_create(csc_compare cmp)
+{
+    return csc_cflatset_create_with_allocator(cmp, csc_default_allocator());
+}
+
+cflatset* csc_cflatset_create_with_allocator(csc_compare cmp, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    return _create(csc_cvector_create_with_allocator(allocator), cmp, allocator);
+}
+
+cflatset* csc_cflatset_create_sized(size_t elem_size, csc_compare cmp)
+{
+    return csc_cflatset_create_sized_with_allocator(elem_size, cmp, csc_default_allocator());
+}
+
+cflatset* csc_cflatset_create_sized_with_allocator(size_t elem_size, csc_compare cmp, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    return _create(csc_cvector_create_sized_with_allocator(elem_size, allocator), cmp, allocator);
+}
+
+void csc_cflatset_destroy(cflatset* s)
+{
+    assert(s != NULL);
+    const csc_allocator a = s->allocator;
+    csc_cvector_destroy(s->v);
+    a.free(s, sizeof(*s), a.context);
+}
+
+CSCError csc_cflatset_add(cflatset* s, void* elem)
+{
+    assert(s != NULL);
+    if (elem == NULL) {
+        return E_INVALIDOPERATION;
+    }
+
+    const size_t idx = csc_cvector_lower_bound(s->v, elem, s->cmp);
+    if (idx < csc_cvector_size(s->v) && s->cmp(csc_cvector_at(s->v, idx), elem) == 0) {
+        return E_INVALIDOPERATION;
+    }
+    return csc_cvector_insert(s->v, idx, elem);
+}
+
+void* csc_cflatset_rm(cflatset* s, const void* elem)
+{
+    assert(s != NULL);
+    if (elem == NULL) {
+        return NULL;
+    }
+
+    const size_t idx = csc_cvector_lower_bound(s->v, elem, s->cmp);
+    if (idx == csc_cvector_size(s->v) || s->cmp(csc_cvector_at(s->v, idx), elem) != 0) {
+        return NULL;
+    }
+    return csc_cvector_rm_at_ordered(s->v, idx);
+}
+
+void* csc_cflatset_find(const cflatset* s, const void* elem)
+{
+    assert(s != NULL);
+    if (elem == NULL) {
+        return NULL;
+    }
+    return csc_cvector_bsearch(s->v, elem, s->cmp);
+}
+
+void* csc_cflatset_at(const cflatset* s, size_t idx)
+{
+    assert(s != NULL);
+    return csc_cvector_at(s->v, idx);
+}
+
+size_t csc_cflatset_size(const cflatset* s)
+{
+    assert(s != NULL);
+    return csc_cvector_size(s->v);
+}
+
+bool csc_cflatset_empty(const cflatset* s)
+{
+    assert(s != NULL);
+    return csc_cvector_empty(s->v);
+}
+
+CSCError csc_cflatset_reserve(cflatset* s, size_t num_elems)
+{
+    assert(s != NULL);
+    return csc_cvector_reserve(s->v, num_elems);
+}
+
+void csc_cflatset_foreach(cflatset* s, csc_foreach fn, void* context)
+{
+    assert(s != NULL);
+    csc_cvector_foreach(s->v, fn, context);
+}
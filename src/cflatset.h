@@ -0,0 +1,235 @@
+#pragma once
+
+/**
+ * @file cflatset.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #cflatset data structure.
+ *
+ * #cflatset implements an ordered set on top of a sorted #cvector. Lookups are binary searches over a contiguous
+ * array which makes the set far more cache friendly than a #cbst. The price is that insertions shift the elements
+ * after the insertion point, so the set is best suited to read-heavy data that is rarely modified. As with #cbst,
+ * duplicate and @c NULL elements are not allowed.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // create a set of ints stored by value
+ * cflatset* s = csc_cflatset_create_sized(sizeof(int), csc_cmp_int);
+ * if (s == NULL) {
+ *      // couldn't create the set
+ * }
+ *
+ * // add some elements
+ * int elems[] = {5, 3, 7};
+ * for (int i = 0; i < 3; ++i) {
+ *      CSCError e = csc_cflatset_add(s, &elems[i]);
+ *      if (e != E_NOERR) {
+ *          // handle the error
+ *      }
+ * }
+ *
+ * // find an element
+ * int x = 3;
+ * int* found = (int*) csc_cflatset_find(s, &x);
+ * if (found == NULL) {
+ *      // element wasn't found
+ * }
+ *
+ * // the elements are kept in order: 3, 5, 7
+ * int* smallest = (int*) csc_cflatset_at(s, 0);
+ *
+ * // clean up
+ * csc_cflatset_destroy(s);
+ * @endcode
+ *
+ * @see cvector.h
+ */
+
+#include "csc.h"
+
+/**
+ * @brief implementation of an ordered set backed by a sorted array.
+ *
+ * @see csc_cflatset_create
+ */
+typedef struct cflatset cflatset;
+
+/**
+ * @brief cflatset "constructor" function
+ *
+ * This function creates a set that stores @c void* elements ordered by @p cmp. As with #cbst, the set does @b not
+ * own the elements.
+ *
+ * @param cmp the comparison function that defines the order of the set. See #csc_compare for more details.
+ *
+ * @return a pointer to a constructed #cflatset or @c NULL on failure.
+ *
+ * @see csc_cflatset_destroy
+ */
+cflatset* csc_cflatset_create(csc_compare cmp);
+
+/**
+ * @brief cflatset "constructor" function for inline element storage.
+ *
+ * This function creates a set that stores elements of @p elem_size bytes by value, in the same way as
+ * #csc_cvector_create_sized. @p cmp receives pointers to the stored elements.
+ *
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param cmp the comparison function that defines the order of the set. See #csc_compare for more details.
+ *
+ * @return a pointer to a constructed #cflatset. On failure or if @p elem_size is 0, @c NULL is returned.
+ *
+ * @see csc_cflatset_destroy
+ */
+cflatset* csc_cflatset_create_sized(size_t elem_size, csc_compare cmp);
+
+/**
+ * @brief cflatset "constructor" function using a custom allocator.
+ *
+ * This function is identical to #csc_cflatset_create except that the set and its data are allocated through
+ * @p allocator.
+ *
+ * @param cmp the comparison function that defines the order of the set. See #csc_compare for more details.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a constructed #cflatset or @c NULL on failure.
+ *
+ * @see csc_cflatset_destroy
+ */
+cflatset* csc_cflatset_create_with_allocator(csc_compare cmp, const csc_allocator* allocator);
+
+/**
+ * @brief cflatset "constructor" function for inline element storage using a custom allocator.
+ *
+ * This function is identical to #csc_cflatset_create_sized except that the set and its data are allocated through
+ * @p allocator.
+ *
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param cmp the comparison function that defines the order of the set. See #csc_compare for more details.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a constructed #cflatset. On failure or if @p elem_size is 0, @c NULL is returned.
+ *
+ * @see csc_cflatset_destroy
+ */
+cflatset* csc_cflatset_create_sized_with_allocator(size_t elem_size, csc_compare cmp, const csc_allocator* allocator);
+
+/**
+ * @brief cflatset "destructor" function
+ *
+ * This function must be called whenever a cflatset is no longer used.
+ *
+ * @see csc_cflatset_create
+ */
+void csc_cflatset_destroy(cflatset* s);
+
+/**
+ * @brief adds an element into the set, keeping the set ordered.
+ *
+ * Both @p elem and @p s are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(n)) to find the position and @c O(n) to shift the elements after it.
+ *
+ * @param s the set.
+ * @param elem the element to add.
+ *
+ * @return On success, @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM. If a duplicate element
+ * is attempted to be added, @c CSCError#E_INVALIDOPERATION.
+ */
+CSCError csc_cflatset_add(cflatset* s, void* elem);
+
+/**
+ * @brief removes an element from the set, keeping the set ordered.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(n)) to find the element and @c O(n) to shift the elements after it.
+ *
+ * @param s the set.
+ * @param elem the element to remove.
+ *
+ * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL. For inline storage,
+ * the returned pointer is valid until the set is next modified.
+ */
+void* csc_cflatset_rm(cflatset* s, const void* elem);
+
+/**
+ * @brief finds the element in the set.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log(n))
+ *
+ * @param s the set.
+ * @param elem the element to find.
+ *
+ * @return the element or @c NULL if the element couldn't be found. For inline storage, a pointer to the stored element.
+ */
+void* csc_cflatset_find(const cflatset* s, const void* elem);
+
+/**
+ * @brief returns the element at the specified 0-indexed position in the set's order.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param s the set.
+ * @param idx the index.
+ *
+ * @return the element at that position or @c NULL if the index is out of range.
+ */
+void* csc_cflatset_at(const cflatset* s, size_t idx);
+
+/**
+ * @brief returns the size of the set.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param s the set.
+ *
+ * @return the size of the set.
+ */
+size_t csc_cflatset_size(const cflatset* s);
+
+/**
+ * @brief checks if the set is empty.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param s the set.
+ *
+ * @return @c true if the set is empty. Otherwise, @c false.
+ */
+bool csc_cflatset_empty(const cflatset* s);
+
+/**
+ * @brief reserves memory for the specified number of elements in the set.
+ *
+ * See #csc_cvector_reserve for more details.
+ *
+ * @param s the set.
+ * @param num_elems the number of elements to allocate memory for.
+ *
+ * @return On success @c CSCError#E_NOERR. If the requested size is less than the current size,
+ * @c CSCError#E_INVALIDOPERATION. If there is a memory error, @c CSCError#E_OUTOFMEM.
+ */
+CSCError csc_cflatset_reserve(cflatset* s, size_t num_elems);
+
+/**
+ * @brief applies the callback function to each element of the set in order.
+ *
+ * <b>Time Complexity:</b> @c O(n)
+ *
+ * @param s the set.
+ * @param fn the callback function to apply to each element.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ *
+ * @see csc_foreach
+ */
+void csc_cflatset_foreach(cflatset* s, csc_foreach fn, void* context);
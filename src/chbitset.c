@@ -0,0 +1,232 @@
+/**
+ * @file chbitset.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #chbitset data structure.
+ *
+ * @see chbitset.h
+ *
+ */
+
+#include "chbitset.h"
+#include <assert.h>
+#include <string.h>
+
+// the summary levels are 64 bits wide on every platform so each level is 64 times smaller than the one below.
+#define CSC_BITSIZE 64
+
+// enough levels to summarize SIZE_MAX bits down to a single word.
+#define CSC_MAX_LEVELS 11
+
+struct chbitset {
+    size_t nbits;   /**< The number of bits the bitset can hold. */
+    size_t nlevels; /**< The number of levels, including the bits themselves. */
+    uint64_t* levels[CSC_MAX_LEVELS]; /**< The words of each level. Level 0 holds the bits. */
+    size_t sizes[CSC_MAX_LEVELS];     /**< The number of words in each level. The last level has a single word. */
+    csc_allocator allocator; /**< The allocator used for the bitset. */
+};
+
+// returns the number of words needed to store n bits.
+static size_t _words_for(size_t n)
+{
+    return (n / CSC_BITSIZE) + ((n % CSC_BITSIZE) != 0 ? 1 : 0);
+}
+
+// returns the total number of words in every level of a bitset of nbits.
+static size_t _total_words(size_t nbits)
+{
+    size_t total = 0;
+    size_t n = _words_for(nbits);
+    for (;;) {
+        total += n;
+        if (n == 1) {
+            return total;
+        }
+        n = _words_for(n);
+    }
+}
+
+// returns the size of the single block holding the bitset and every level.
+static size_t _block_size(size_t nbits)
+{
+    return (_total_words(nbits) * sizeof(uint64_t)) + sizeof(chbitset);
+}
+
+// follows the set bit pos of level k down to the lowest set bit of level 0 it summarizes.
+static size_t _descend(const chbitset* b, size_t k, size_t pos)
+{
+    while (k > 0) {
+        --k;
+        pos = (pos * CSC_BITSIZE) + csc_ctz64(b->levels[k][pos]);
+    }
+    return pos;
+}
+
+chbitset* csc_chbitset_create(size_t nbits)
+{
+    return csc_chbitset_create_with_allocator(nbits, csc_default_allocator());
+}
+
+chbitset* csc_chbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+
+    // zero sized bitset is not allowed.
+    if (nbits == 0) {
+        return NULL;
+    }
+
+    const size_t block_size = _block_size(nbits);
+    char* data = allocator->alloc(block_size, allocator->context);
+    if (data == NULL) {
+        return NULL;
+    }
+    memset(data, 0, block_size);
+
+    // the levels are laid out one after another, from the bits up to the single top word.
+    chbitset* b = (chbitset*)data;
+    uint64_t* words = (uint64_t*)(data + sizeof(chbitset));
+    size_t n = _words_for(nbits);
+    b->nlevels = 0;
+    for (;;) {
+        b->levels[b->nlevels] = words;
+        b->sizes[b->nlevels] = n;
+        ++b->nlevels;
+        words += n;
+        if (n == 1) {
+            break;
+        }
+        n = _words_for(n);
+    }
+    b->nbits = nbits;
+    b->allocator = *allocator;
+
+    return b;
+}
+
+void csc_chbitset_destroy(chbitset* b)
+{
+    assert(b != NULL);
+    const csc_allocator a = b->allocator;
+    a.free(b, _block_size(b->nbits), a.context);
+}
+
+size_t csc_chbitset_size(const chbitset* b)
+{
+    assert(b != NULL);
+    return b->nbits;
+}
+
+CSCError csc_chbitset_set(chbitset* b, size_t bit)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        return E_OUTOFRANGE;
+    }
+
+    // mark the word in the level above as non-zero until reaching a word that already was.
+    size_t pos = bit;
+    for (size_t k = 0; k < b->nlevels; ++k) {
+        uint64_t* word = &(b->levels[k][pos / CSC_BITSIZE]);
+        const bool was_zero = *word == 0;
+        *word |= (uint64_t)1 << (pos % CSC_BITSIZE);
+        if (!was_zero) {
+            break;
+        }
+        pos /= CSC_BITSIZE;
+    }
+    return E_NOERR;
+}
+
+CSCError csc_chbitset_clear(chbitset* b, size_t bit)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        return E_OUTOFRANGE;
+    }
+
+    // mark the word in the level above as zero for as long as clearing the bit empties a word.
+    size_t pos = bit;
+    for (size_t k = 0; k < b->nlevels; ++k) {
+        uint64_t* word = &(b->levels[k][pos / CSC_BITSIZE]);
+        *word &= ~((uint64_t)1 << (pos % CSC_BITSIZE));
+        if (*word != 0) {
+            break;
+        }
+        pos /= CSC_BITSIZE;
+    }
+    return E_NOERR;
+}
+
+bool csc_chbitset_at(const chbitset* b, size_t bit, CSCError* e)
+{
+    assert(b != NULL);
+    if (bit >= b->nbits) {
+        if (e != NULL) {
+            *e = E_OUTOFRANGE;
+        }
+        return false;
+    }
+
+    if (e != NULL) {
+        *e = E_NOERR;
+    }
+    return (b->levels[0][bit / CSC_BITSIZE] & ((uint64_t)1 << (bit % CSC_BITSIZE))) != 0;
+}
+
+bool csc_chbitset_empty(const chbitset* b)
+{
+    assert(b != NULL);
+    return b->levels[b->nlevels - 1][0] == 0;
+}
+
+size_t csc_chbitset_find_first(const chbitset* b)
+{
+    assert(b != NULL);
+    const size_t top = b->nlevels - 1;
+    if (b->levels[top][0] == 0) {
+        return b->nbits;
+    }
+    return _descend(b, top, csc_ctz64(b->levels[top][0]));
+}
+
+size_t csc_chbitset_find_next(const chbitset* b, size_t from)
+{
+    assert(b != NULL);
+    if (from >= b->nbits) {
+        return b->nbits;
+    }
+
+    // pos is the first candidate bit of level k. if its word has nothing at or after it,
+    // the next candidate is the following word, which is the next bit of the level above.
+    size_t pos = from;
+    for (size_t k = 0; k < b->nlevels; ++k) {
+        const size_t idx = pos / CSC_BITSIZE;
+        if (idx >= b->sizes[k]) {
+            break;
+        }
+
+        const uint64_t word = b->levels[k][idx] & (~(uint64_t)0 << (pos % CSC_BITSIZE));
+        if (word != 0) {
+            return _descend(b, k, (idx * CSC_BITSIZE) + csc_ctz64(word));
+        }
+        pos = idx + 1;
+    }
+    return b->nbits;
+}
+
+void csc_chbitset_foreach(const chbitset* b, csc_bit_foreach fn, void* context)
+{
+    assert(b != NULL);
+
+    // find each non-zero word through the summaries, then enumerate its bits directly.
+    for (size_t bit = csc_chbitset_find_first(b); bit < b->nbits;) {
+        const size_t idx = bit / CSC_BITSIZE;
+        uint64_t word = b->levels[0][idx];
+        while (word != 0) {
+            fn((idx * CSC_BITSIZE) + csc_ctz64(word), context);
+            word &= word - 1;
+        }
+        bit = csc_chbitset_find_next(b, (idx + 1) * CSC_BITSIZE);
+    }
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * @file chbitset.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #chbitset data structure.
+ *
+ * A #chbitset is a fixed size bitset for large, mostly empty sets of bits. Next to the bits themselves it keeps
+ * summary levels: bit @c i of a summary word is set if word @c i of the level below is non-zero. Levels are added
+ * until a level fits in a single word, so searching for the next set bit skips empty regions of the bitset by
+ * climbing and descending the summaries instead of reading every word.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // a bitset of 100 million bits
+ * chbitset* b = csc_chbitset_create(100000000);
+ *
+ * csc_chbitset_set(b, 42);
+ * csc_chbitset_set(b, 99999999);
+ *
+ * // visits 42 and 99999999 without scanning the empty words in between
+ * for (size_t bit = csc_chbitset_find_first(b); bit != csc_chbitset_size(b);
+ *      bit = csc_chbitset_find_next(b, bit + 1)) {
+ *      // use bit
+ * }
+ *
+ * csc_chbitset_destroy(b);
+ * @endcode
+ *
+ * Setting or clearing a bit only touches the summaries when a word changes between zero and non-zero. The
+ * summaries take about @c 1/63 of the memory of the bits.
+ *
+ * @see cbitset.h
+ *
+ */
+
+#include "cbitset.h"
+
+/**
+ * @brief the chbitset data structure.
+ *
+ * Unlike #cbitset, the size of the bitset is fixed at creation.
+ *
+ */
+typedef struct chbitset chbitset;
+
+/**
+ * @brief creates a #chbitset.
+ *
+ * This function creates a #chbitset capable of holding @p nbits of data. Note that @p nbits must be greater than 0.
+ * The bitset is initialized with all of the bits cleared.
+ *
+ * @param nbits the number of bits the bitset should manage.
+ *
+ * @return a pointer to a #chbitset if successful. On failure or if @p nbits is 0, @c NULL is returned.
+ *
+ * @see csc_chbitset_destroy
+ *
+ */
+chbitset* csc_chbitset_create(size_t nbits);
+
+/**
+ * @brief creates a #chbitset using a custom allocator.
+ *
+ * This function is identical to #csc_chbitset_create except that the bitset is allocated through @p allocator.
+ *
+ * @param nbits the number of bits the bitset should manage.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a #chbitset if successful. On failure or if @p nbits is 0, @c NULL is returned.
+ *
+ * @see csc_chbitset_destroy
+ *
+ */
+chbitset* csc_chbitset_create_with_allocator(size_t nbits, const csc_allocator* allocator);
+
+/**
+ * @brief destroys a #chbitset.
+ *
+ * @param b the bitset to destroy. Must be @b non-null.
+ *
+ */
+void csc_chbitset_destroy(chbitset* b);
+
+/**
+ * @brief returns the number of bits the bitset holds.
+ *
+ * @param b the bitset. Must be @b non-null.
+ *
+ * @return the number of bits.
+ */
+size_t csc_chbitset_size(const chbitset* b);
+
+/**
+ * @brief sets the bit at the specified 0-indexed position.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1). @c O(log64(n)) if the bit's word was zero.
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to set.
+ *
+ * @return On success, @c CSCError#E_NOERR. If @p bit is out of range, @c CSCError#E_OUTOFRANGE.
+ *
+ */
+CSCError csc_chbitset_set(chbitset* b, size_t bit);
+
+/**
+ * @brief clears the bit at the specified 0-indexed position.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1). @c O(log64(n)) if the bit's word becomes zero.
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to clear.
+ *
+ * @return On success, @c CSCError#E_NOERR. If @p bit is out of range, @c CSCError#E_OUTOFRANGE.
+ *
+ */
+CSCError csc_chbitset_clear(chbitset* b, size_t bit);
+
+/**
+ * @brief retrieves the state of the bit at the specified 0-indexed position.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitset.
+ * @param bit the 0-indexed bit to check.
+ * @param e @b optional parameter to retrieve any errors. Can be @c NULL.
+ *
+ * @return On success, @p e is @c CSCError#E_NOERR. If @p bit is out of range, @p e is @c CSCError#E_OUTOFRANGE.
+ * If the bit is set, @c true is returned and @c false otherwise.
+ *
+ */
+bool csc_chbitset_at(const chbitset* b, size_t bit, CSCError* e);
+
+/**
+ * @brief determines if no bit is set.
+ *
+ * Only the top summary word is read.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param b the bitset. Must be @b non-null.
+ *
+ * @return @c true if no bit is set and @c false otherwise.
+ */
+bool csc_chbitset_empty(const chbitset* b);
+
+/**
+ * @brief returns the index of the lowest set bit.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log64(n))
+ *
+ * @param b the bitset.
+ *
+ * @return the index of the lowest set bit or the size of the bitset if no bit is set.
+ */
+size_t csc_chbitset_find_first(const chbitset* b);
+
+/**
+ * @brief returns the index of the lowest set bit at or after @p from.
+ *
+ * The search climbs the summary levels until it finds a non-zero word after @p from and then descends to the bit,
+ * so empty regions are skipped regardless of their size. To visit every set bit, start with
+ * #csc_chbitset_find_first and pass the previous result plus one.
+ *
+ * @p b is expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(log64(n))
+ *
+ * @param b the bitset.
+ * @param from the first bit to consider.
+ *
+ * @return the index of the bit or the size of the bitset if no bit at or after @p from is set.
+ */
+size_t csc_chbitset_find_next(const chbitset* b, size_t from);
+
+/**
+ * @brief applies the callback function to the index of each set bit in ascending order.
+ *
+ * Non-zero words are located through the summary levels, so the cost depends on the number of set bits rather than
+ * the size of the bitset. The bitset must not be modified by the callback.
+ *
+ * <b>Time Complexity:</b> @c O(k * log64(n)) where @c k is the number of set bits.
+ *
+ * @param b the bitset. Must be @b non-null.
+ * @param fn the callback function. Must be @b non-null.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ *
+ */
+void csc_chbitset_foreach(const chbitset* b, csc_bit_foreach fn, void* context);
@@ -31,6 +31,38 @@ int csc_cmp_##type(const void* a, const void* b) \
 
 CSC_DEFINE_BUILTIN_CMP(int)
 
+static void* _default_alloc(size_t size, void* context)
+{
+    CSC_UNUSED(context);
+    return malloc(size);
+}
+
+static void* _default_realloc(void* ptr, size_t old_size, size_t new_size, void* context)
+{
+    CSC_UNUSED(old_size);
+    CSC_UNUSED(context);
+    return realloc(ptr, new_size);
+}
+
+static void _default_free(void* ptr, size_t size, void* context)
+{
+    CSC_UNUSED(size);
+    CSC_UNUSED(context);
+    free(ptr);
+}
+
+static const csc_allocator _default_allocator = {
+    .alloc = _default_alloc,
+    .realloc = _default_realloc,
+    .free = _default_free,
+    .context = NULL
+};
+
+const csc_allocator* csc_default_allocator(void)
+{
+    return &_default_allocator;
+}
+
 void csc_swap(void** a, void** b)
 {
     void* c = *a;
@@ -53,6 +85,9 @@ void csc_error_str(CSCError e, char* buf, size_t len)
     case E_OUTOFRANGE:
         strncpy(buf, "the last operation requested an out of range element.", len);
         break;
+    case E_IO:
+        strncpy(buf, "the last operation's file access failed.", len);
+        break;
     default:
         break;
     }
@@ -43,6 +43,12 @@
     #error "Architecture or environment not currently supported."
 #endif
 
+// SIMD kernels are compiled with per-function target attributes and selected at runtime
+// so the library itself can still be built for the baseline instruction set.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define CSC_X86_SIMD
+#endif
+
 // This macro block will only be defined during a Doxygen run.
 // The extra indirection is necessary because Doxygen will only generate documentation for define'd macros.
 // This method allows us to define the macros only during a Doxygen run and leave them undef'd during a normal
@@ -60,6 +66,14 @@
      * 
      */
     #define CSC_32
+
+    /**
+     * @brief This macro is only defined if the compiler supports x86 SIMD intrinsics with runtime CPU dispatch.
+     * 
+     * When it is not defined, the library falls back to scalar implementations.
+     * 
+     */
+    #define CSC_X86_SIMD
 #endif
 
 /**
@@ -88,6 +102,7 @@ typedef enum CSCError {
     E_OUTOFMEM, /**< This error indicates the operation failed since memory could not be allocated. */
     E_OUTOFRANGE, /**< This error indicates that the operation failed due to accessing an out of range element. i.e. array index of -1. */
     E_INVALIDOPERATION, /**< This error indicates that the operation failed because an invalid operation was attempted. */
+    E_IO, /**< This error indicates that the operation failed because a file couldn't be opened, read or written. */
     E_ERR_N /**< This is never returned by any function calls and can be ignored. */
 } CSCError;
 
@@ -131,6 +146,98 @@ typedef int (*csc_compare)(const void* a, const void* b);
  */
 typedef void (*csc_foreach)(void* elem, void* context);
 
+/**
+ * @brief callback function for testing a condition on the elements of a container.
+ * 
+ * This callback function decides whether an element satisfies a user-defined condition, for instance to select
+ * which elements an operation should apply to.
+ * 
+ * @param elem the element to test
+ * @param context user-defined data that can be passed into the function. Can be @c NULL if unused.
+ * 
+ * @return @c true if the element satisfies the condition. Otherwise, @c false.
+ * 
+ */
+typedef bool (*csc_predicate)(const void* elem, void* context);
+
+/**
+ * @brief a user-supplied memory allocator.
+ * 
+ * By default, the containers in this library allocate memory with @c malloc, @c realloc and @c free. Containers
+ * created with a @c csc_<container>_create_with_allocator function route every allocation they make through the
+ * supplied allocator instead. This allows containers to use arenas, pools or bump allocators.
+ * 
+ * The sizes of the blocks are always passed back to the allocator so allocators that don't track block sizes, such
+ * as bump allocators, can implement @c csc_allocator#realloc by copying @p old_size bytes. Memory returned by
+ * @c csc_allocator#alloc does not need to be zeroed but must be suitably aligned for any type, as with @c malloc.
+ * 
+ * Containers copy the allocator when they are created so the #csc_allocator itself does not need to outlive the
+ * call. However, @c csc_allocator#context must remain valid for the life of the container.
+ * 
+ * @see csc_default_allocator
+ */
+typedef struct csc_allocator {
+    void* (*alloc)(size_t size, void* context); /**< Allocates @p size bytes. Returns @c NULL on failure. */
+    void* (*realloc)(void* ptr, size_t old_size, size_t new_size, void* context); /**< Resizes a block. Returns @c NULL on failure, leaving @p ptr untouched. */
+    void (*free)(void* ptr, size_t size, void* context); /**< Releases a block. @p ptr may be @c NULL. */
+    void* context; /**< User-defined data passed to each function. Can be @c NULL if unused. */
+} csc_allocator;
+
+/**
+ * @brief returns the allocator used by containers created without an explicit allocator.
+ * 
+ * The default allocator forwards to @c malloc, @c realloc and @c free.
+ * 
+ * @return the default allocator.
+ */
+const csc_allocator* csc_default_allocator(void);
+
+/**
+ * @brief returns the number of trailing zero bits in @p x.
+ * 
+ * This compiles to a single instruction on compilers that provide @c __builtin_ctzll.
+ * 
+ * @param x the value. Must be non-zero.
+ * 
+ * @return the index of the lowest set bit of @p x.
+ */
+static inline unsigned csc_ctz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief returns the number of set bits in @p x.
+ * 
+ * This compiles to a single instruction only when the compiler targets a CPU with a population count instruction
+ * (e.g. @c -mpopcnt on x86). Otherwise it is a portable bit-twiddling routine, so loops that count many words should
+ * dispatch to a @c popcnt kernel at runtime as #cbitset does.
+ * 
+ * @param x the value.
+ * 
+ * @return the number of set bits.
+ */
+static inline unsigned csc_popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
 /**
  * @brief convenience macro defining comparison functions for built in types.
  * 
@@ -0,0 +1,159 @@
+/**
+ * @file csoa.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the #csoa data structure.
+ *
+ * @see csoa.h
+ *
+ */
+
+#include "csoa.h"
+#include "cvector.h"
+#include <assert.h>
+#include <string.h>
+
+struct csoa {
+    size_t size; /**< The number of rows, shared by every column. */
+    size_t ncols; /**< The number of columns. */
+    csc_allocator allocator; /**< The allocator used for the table. */
+    cvector* columns[]; /**< One inline vector per column. */
+};
+
+static size_t _block_size(size_t ncols)
+{
+    return sizeof(csoa) + (ncols * sizeof(cvector*));
+}
+
+csoa* csc_csoa_create(const size_t* col_sizes, size_t ncols)
+{
+    return csc_csoa_create_with_allocator(col_sizes, ncols, csc_default_allocator());
+}
+
+csoa* csc_csoa_create_with_allocator(const size_t* col_sizes, size_t ncols, const csc_allocator* allocator)
+{
+    assert(col_sizes != NULL);
+    assert(allocator != NULL);
+    if (ncols == 0 || ncols > (SIZE_MAX - sizeof(csoa)) / sizeof(cvector*)) {
+        return NULL;
+    }
+
+    csoa* t = allocator->alloc(_block_size(ncols), allocator->context);
+    if (t == NULL) {
+        return NULL;
+    }
+    memset(t, 0, _block_size(ncols));
+    t->ncols = ncols;
+    t->allocator = *allocator;
+
+    for (size_t i = 0; i < ncols; ++i) {
+        t->columns[i] = csc_cvector_create_sized_with_allocator(col_sizes[i], allocator);
+        if (t->columns[i] == NULL) {
+            csc_csoa_destroy(t);
+            return NULL;
+        }
+    }
+    return t;
+}
+
+void csc_csoa_destroy(csoa* t)
+{
+    assert(t != NULL);
+    const csc_allocator a = t->allocator;
+    for (size_t i = 0; i < t->ncols; ++i) {
+        if (t->columns[i] != NULL) {
+            csc_cvector_destroy(t->columns[i]);
+        }
+    }
+    a.free(t, _block_size(t->ncols), a.context);
+}
+
+CSCError csc_csoa_add(csoa* t, void* const* row)
+{
+    assert(t != NULL);
+    assert(row != NULL);
+    for (size_t i = 0; i < t->ncols; ++i) {
+        CSCError e = csc_cvector_add(t->columns[i], row[i]);
+        if (e != E_NOERR) {
+            // undo the columns that already took the row so every column keeps the same size.
+            while (i-- > 0) {
+                csc_cvector_rm_at(t->columns[i], t->size);
+            }
+            return e;
+        }
+    }
+    ++t->size;
+
+    return E_NOERR;
+}
+
+CSCError csc_csoa_rm_at(csoa* t, size_t row)
+{
+    assert(t != NULL);
+    if (row >= t->size) {
+        return E_OUTOFRANGE;
+    }
+
+    for (size_t i = 0; i < t->ncols; ++i) {
+        csc_cvector_rm_at(t->columns[i], row);
+    }
+    --t->size;
+
+    return E_NOERR;
+}
+
+void* csc_csoa_at(const csoa* t, size_t col, size_t row)
+{
+    assert(t != NULL);
+    if (col >= t->ncols) {
+        return NULL;
+    }
+    return csc_cvector_at(t->columns[col], row);
+}
+
+void* csc_csoa_column(const csoa* t, size_t col)
+{
+    return csc_csoa_at(t, col, 0);
+}
+
+size_t csc_csoa_size(const csoa* t)
+{
+    assert(t != NULL);
+    return t->size;
+}
+
+size_t csc_csoa_columns(const csoa* t)
+{
+    assert(t != NULL);
+    return t->ncols;
+}
+
+bool csc_csoa_empty(const csoa* t)
+{
+    assert(t != NULL);
+    return t->size == 0;
+}
+
+CSCError csc_csoa_reserve(csoa* t, size_t num_rows)
+{
+    assert(t != NULL);
+    if (num_rows < t->size) {
+        return E_INVALIDOPERATION; // no information loss allowed
+    }
+
+    for (size_t i = 0; i < t->ncols; ++i) {
+        CSCError e = csc_cvector_reserve(t->columns[i], num_rows);
+        if (e != E_NOERR) {
+            return e;
+        }
+    }
+    return E_NOERR;
+}
+
+void csc_csoa_foreach(csoa* t, size_t col, csc_foreach fn, void* context)
+{
+    assert(t != NULL);
+    if (col < t->ncols) {
+        csc_cvector_foreach(t->columns[col], fn, context);
+    }
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+/**
+ * @file csoa.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the interface to the #csoa data structure.
+ *
+ * #csoa implements a columnar table, also known as a structure of arrays. Instead of storing whole records in a
+ * single vector, each field of the records is stored in its own inline #cvector and all columns share the same
+ * number of rows. Scanning a single field then only touches the bytes of that field, which makes filter and
+ * aggregate passes over one or two fields of wide records far more cache friendly.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // a table of (id, price) records
+ * const size_t columns[] = {sizeof(int), sizeof(double)};
+ * csoa* t = csc_csoa_create(columns, 2);
+ * if (t == NULL) {
+ *      // couldn't create the table
+ * }
+ *
+ * // append a row. Each field is copied into its column.
+ * int id = 1;
+ * double price = 9.99;
+ * void* row[] = {&id, &price};
+ * CSCError e = csc_csoa_add(t, row);
+ * if (e != E_NOERR) {
+ *      // couldn't add the row
+ * }
+ *
+ * // scan the price column only
+ * const double* prices = (const double*) csc_csoa_column(t, 1);
+ * double total = 0;
+ * for (size_t i = 0; i < csc_csoa_size(t); ++i) {
+ *      total += prices[i];
+ * }
+ *
+ * // clean up
+ * csc_csoa_destroy(t);
+ * @endcode
+ *
+ * @see cvector.h
+ */
+
+#include "csc.h"
+
+/**
+ * @brief implementation of a columnar table of fixed-size fields.
+ *
+ * @see csc_csoa_create
+ */
+typedef struct csoa csoa;
+
+/**
+ * @brief csoa "constructor" function
+ *
+ * This function creates an empty table with @p ncols columns. Column @c i stores fields of @c col_sizes[i] bytes
+ * by value, in the same way as #csc_cvector_create_sized.
+ *
+ * @param col_sizes the size, in bytes, of a field of each column. Every size must be greater than 0.
+ * @param ncols the number of columns. Must be greater than 0.
+ *
+ * @return a pointer to a constructed #csoa. On failure, or if @p ncols or any column size is 0, @c NULL is returned.
+ *
+ * @see csc_csoa_destroy
+ */
+csoa* csc_csoa_create(const size_t* col_sizes, size_t ncols);
+
+/**
+ * @brief csoa "constructor" function using a custom allocator.
+ *
+ * This function is identical to #csc_csoa_create except that the table and its columns are allocated through
+ * @p allocator.
+ *
+ * @param col_sizes the size, in bytes, of a field of each column. Every size must be greater than 0.
+ * @param ncols the number of columns. Must be greater than 0.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ *
+ * @return a pointer to a constructed #csoa. On failure, or if @p ncols or any column size is 0, @c NULL is returned.
+ *
+ * @see csc_csoa_destroy
+ */
+csoa* csc_csoa_create_with_allocator(const size_t* col_sizes, size_t ncols, const csc_allocator* allocator);
+
+/**
+ * @brief csoa "destructor" function
+ *
+ * This function must be called whenever a csoa is no longer used.
+ *
+ * @see csc_csoa_create
+ */
+void csc_csoa_destroy(csoa* t);
+
+/**
+ * @brief appends a row to the table.
+ *
+ * Field @c i of the row is copied from @c row[i] into column @c i. The row is either added to every column or,
+ * on failure, to none of them.
+ *
+ * All parameters are expected to be @b non-null and @p row must hold one @b non-null field per column.
+ *
+ * <b>Time Complexity:</b> @c O(c) amortized where @c c is the number of columns.
+ *
+ * @param t the table.
+ * @param row the fields of the row.
+ *
+ * @return On success, @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM.
+ */
+CSCError csc_csoa_add(csoa* t, void* const* row);
+
+/**
+ * @brief removes a row from the table.
+ *
+ * As with #csc_cvector_rm_at, the last row is moved into the removed row's position in every column.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(c) where @c c is the number of columns.
+ *
+ * @param t the table.
+ * @param row the index of the row to remove.
+ *
+ * @return On success, @c CSCError#E_NOERR. If @p row is out of range, @c CSCError#E_OUTOFRANGE.
+ */
+CSCError csc_csoa_rm_at(csoa* t, size_t row);
+
+/**
+ * @brief returns a pointer to a single field of the table.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param t the table.
+ * @param col the index of the column.
+ * @param row the index of the row.
+ *
+ * @return a pointer to the field or @c NULL if @p col or @p row is out of range. The pointer is invalidated by any
+ * operation that modifies the table.
+ */
+void* csc_csoa_at(const csoa* t, size_t col, size_t row);
+
+/**
+ * @brief returns a pointer to the contiguous fields of a column.
+ *
+ * The fields of the column are packed back to back, so the result can be indexed as an array of
+ * #csc_csoa_size elements of the column's type.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param t the table.
+ * @param col the index of the column.
+ *
+ * @return a pointer to the first field of the column or @c NULL if @p col is out of range or the table is empty.
+ * The pointer is invalidated by any operation that modifies the table.
+ */
+void* csc_csoa_column(const csoa* t, size_t col);
+
+/**
+ * @brief returns the number of rows in the table.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param t the table.
+ *
+ * @return the number of rows.
+ */
+size_t csc_csoa_size(const csoa* t);
+
+/**
+ * @brief returns the number of columns in the table.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param t the table.
+ *
+ * @return the number of columns.
+ */
+size_t csc_csoa_columns(const csoa* t);
+
+/**
+ * @brief checks if the table is empty.
+ *
+ * All parameters are expected to be @b non-null.
+ *
+ * <b>Time Complexity:</b> @c O(1)
+ *
+ * @param t the table.
+ *
+ * @return @c true if the table has no rows. Otherwise, @c false.
+ */
+bool csc_csoa_empty(const csoa* t);
+
+/**
+ * @brief reserves memory for the specified number of rows in every column.
+ *
+ * See #csc_cvector_reserve for more details.
+ *
+ * @param t the table.
+ * @param num_rows the number of rows to allocate memory for.
+ *
+ * @return On success @c CSCError#E_NOERR. If the requested size is less than the current size,
+ * @c CSCError#E_INVALIDOPERATION. If there is a memory error, @c CSCError#E_OUTOFMEM.
+ */
+CSCError csc_csoa_reserve(csoa* t, size_t num_rows);
+
+/**
+ * @brief applies the callback function to each field of a single column.
+ *
+ * The callback receives a pointer to each field of column @p col in row order. Only that column's memory is
+ * touched.
+ *
+ * <b>Time Complexity:</b> @c O(n)
+ *
+ * @param t the table. Must be @b non-null.
+ * @param col the index of the column. Nothing happens if it is out of range.
+ * @param fn the callback function. Must be @b non-null.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ */
+void csc_csoa_foreach(csoa* t, size_t col, csc_foreach fn, void* context);
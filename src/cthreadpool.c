@@ -0,0 +1,213 @@
+/**
+ * @file cthreadpool.c
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief implementation of the worker pool.
+ *
+ * @see cthreadpool.h
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cthreadpool.h"
+#include <assert.h>
+
+#ifndef _WIN32
+    #define CSC_PTHREADS
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+struct cthreadpool {
+    size_t nthreads; /**< The number of threads, including the calling thread. */
+#ifdef CSC_PTHREADS
+    pthread_t* workers; /**< The nthreads - 1 worker threads. */
+    pthread_mutex_t run_lock; /**< Serializes concurrent runs. */
+    pthread_mutex_t lock; /**< Guards every field below. */
+    pthread_cond_t work; /**< Signaled when a run starts or the pool stops. */
+    pthread_cond_t done; /**< Signaled when the last task of a run completes. */
+    size_t generation; /**< Incremented once per run so sleeping workers can tell a new run apart. */
+    size_t next; /**< The next unclaimed task. */
+    size_t completed; /**< The number of tasks of the run that have finished. */
+    size_t ntasks; /**< The total number of tasks of the run. */
+    csc_task fn; /**< The task callback. */
+    void* context; /**< The user context passed to each task. */
+    bool stop; /**< Set when the pool is destroyed. */
+#endif
+};
+
+static void _run_serial(size_t ntasks, csc_task fn, void* context)
+{
+    for (size_t t = 0; t < ntasks; ++t) {
+        fn(t, context);
+    }
+}
+
+#ifdef CSC_PTHREADS
+
+// runs tasks of the current run until none are left. Must be called with the lock held; returns with it held.
+static void _drain(cthreadpool* p)
+{
+    const csc_task fn = p->fn;
+    void* context = p->context;
+    while (p->next < p->ntasks) {
+        const size_t task = p->next++;
+        pthread_mutex_unlock(&(p->lock));
+        fn(task, context);
+        pthread_mutex_lock(&(p->lock));
+        if (++p->completed == p->ntasks) {
+            pthread_cond_signal(&(p->done));
+        }
+    }
+}
+
+static void* _worker(void* arg)
+{
+    cthreadpool* p = (cthreadpool*)arg;
+    pthread_mutex_lock(&(p->lock));
+    size_t seen = p->generation;
+    while (true) {
+        while (!p->stop && p->generation == seen) {
+            pthread_cond_wait(&(p->work), &(p->lock));
+        }
+        if (p->stop) {
+            break;
+        }
+        seen = p->generation;
+        _drain(p);
+    }
+    pthread_mutex_unlock(&(p->lock));
+    return NULL;
+}
+
+#endif
+
+size_t csc_threadpool_default_threads(void)
+{
+#ifdef CSC_PTHREADS
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) {
+        return (size_t)n;
+    }
+#endif
+    return 1;
+}
+
+cthreadpool* csc_threadpool_create(size_t nthreads)
+{
+    if (nthreads == 0) {
+        nthreads = csc_threadpool_default_threads();
+    }
+
+    cthreadpool* p = malloc(sizeof(cthreadpool));
+    if (p == NULL) {
+        return NULL;
+    }
+    p->nthreads = 1;
+
+#ifdef CSC_PTHREADS
+    p->workers = NULL;
+    p->generation = 0;
+    p->next = 0;
+    p->completed = 0;
+    p->ntasks = 0;
+    p->fn = NULL;
+    p->context = NULL;
+    p->stop = false;
+    if (nthreads > 1) {
+        p->workers = malloc((nthreads - 1) * sizeof(*(p->workers)));
+    }
+    if (pthread_mutex_init(&(p->run_lock), NULL) != 0) {
+        free(p->workers);
+        free(p);
+        return NULL;
+    }
+    if (pthread_mutex_init(&(p->lock), NULL) != 0) {
+        pthread_mutex_destroy(&(p->run_lock));
+        free(p->workers);
+        free(p);
+        return NULL;
+    }
+    if (pthread_cond_init(&(p->work), NULL) != 0) {
+        pthread_mutex_destroy(&(p->lock));
+        pthread_mutex_destroy(&(p->run_lock));
+        free(p->workers);
+        free(p);
+        return NULL;
+    }
+    if (pthread_cond_init(&(p->done), NULL) != 0) {
+        pthread_cond_destroy(&(p->work));
+        pthread_mutex_destroy(&(p->lock));
+        pthread_mutex_destroy(&(p->run_lock));
+        free(p->workers);
+        free(p);
+        return NULL;
+    }
+
+    // the calling thread is one of the workers; fewer threads are used if some can't be created.
+    if (p->workers != NULL) {
+        while (p->nthreads < nthreads && pthread_create(&(p->workers[p->nthreads - 1]), NULL, _worker, p) == 0) {
+            ++p->nthreads;
+        }
+    }
+#endif
+
+    return p;
+}
+
+void csc_threadpool_destroy(cthreadpool* p)
+{
+    assert(p != NULL);
+#ifdef CSC_PTHREADS
+    pthread_mutex_lock(&(p->lock));
+    p->stop = true;
+    pthread_cond_broadcast(&(p->work));
+    pthread_mutex_unlock(&(p->lock));
+    for (size_t i = 0; i + 1 < p->nthreads; ++i) {
+        pthread_join(p->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&(p->done));
+    pthread_cond_destroy(&(p->work));
+    pthread_mutex_destroy(&(p->lock));
+    pthread_mutex_destroy(&(p->run_lock));
+    free(p->workers);
+#endif
+    free(p);
+}
+
+size_t csc_threadpool_threads(const cthreadpool* p)
+{
+    assert(p != NULL);
+    return p->nthreads;
+}
+
+void csc_threadpool_run(cthreadpool* p, size_t ntasks, csc_task fn, void* context)
+{
+    assert(p != NULL);
+    assert(fn != NULL);
+    if (p->nthreads <= 1 || ntasks <= 1) {
+        _run_serial(ntasks, fn, context);
+        return;
+    }
+
+#ifdef CSC_PTHREADS
+    pthread_mutex_lock(&(p->run_lock));
+    pthread_mutex_lock(&(p->lock));
+    p->fn = fn;
+    p->context = context;
+    p->ntasks = ntasks;
+    p->next = 0;
+    p->completed = 0;
+    ++p->generation;
+    pthread_cond_broadcast(&(p->work));
+
+    _drain(p);
+    while (p->completed < p->ntasks) {
+        pthread_cond_wait(&(p->done), &(p->lock));
+    }
+    pthread_mutex_unlock(&(p->lock));
+    pthread_mutex_unlock(&(p->run_lock));
+#endif
+}
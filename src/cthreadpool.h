@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file cthreadpool.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines the worker pool used by the library's parallel algorithms.
+ *
+ * A #cthreadpool owns a fixed set of worker threads that are created once by #csc_threadpool_create and kept alive
+ * until #csc_threadpool_destroy. Each call to #csc_threadpool_run hands a batch of tasks, identified by their
+ * 0-indexed task number, to the sleeping workers instead of spawning threads, so a pool should be created once and
+ * reused across many runs. The calling thread participates as one of the workers and the call returns once every
+ * task has run. Workers claim tasks dynamically so uneven tasks are balanced across the threads.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // a task that squares one element of an array
+ * void square(size_t task, void* context)
+ * {
+ *      int* elems = (int*) context;
+ *      elems[task] *= elems[task];
+ * }
+ *
+ * //
+ * // somewhere in main...
+ * //
+ *
+ * // a pool of 2 threads, including the calling thread
+ * cthreadpool* p = csc_threadpool_create(2);
+ * if (p == NULL) {
+ *      // couldn't create the pool
+ * }
+ *
+ * int elems[] = {1, 2, 3, 4};
+ *
+ * // run 4 tasks; the pool can be reused for further runs
+ * csc_threadpool_run(p, 4, square, elems);
+ *
+ * csc_threadpool_destroy(p);
+ * @endcode
+ *
+ * On platforms without POSIX threads, the tasks are run serially on the calling thread.
+ *
+ */
+
+#include "csc.h"
+
+/**
+ * @brief the cthreadpool data structure.
+ *
+ */
+typedef struct cthreadpool cthreadpool;
+
+/**
+ * @brief callback function for a single task run by the pool.
+ *
+ * @param task the 0-indexed task number.
+ * @param context user-defined data shared by all tasks. Can be @c NULL if unused.
+ *
+ */
+typedef void (*csc_task)(size_t task, void* context);
+
+/**
+ * @brief returns the number of threads used when a thread count of 0 is requested.
+ *
+ * This is the number of processors currently online or 1 if that can't be determined.
+ *
+ * @return the default number of threads.
+ */
+size_t csc_threadpool_default_threads(void);
+
+/**
+ * @brief creates a #cthreadpool.
+ *
+ * The worker threads are started here and sleep until work is submitted with #csc_threadpool_run. If some threads
+ * can't be created, the pool is smaller than requested; see #csc_threadpool_threads.
+ *
+ * @param nthreads the number of threads to use, including the calling thread. If 0, the value of
+ * #csc_threadpool_default_threads is used.
+ *
+ * @return a pointer to a #cthreadpool if successful. On failure, @c NULL is returned.
+ *
+ * @see csc_threadpool_destroy
+ *
+ */
+cthreadpool* csc_threadpool_create(size_t nthreads);
+
+/**
+ * @brief destroys a #cthreadpool.
+ *
+ * The worker threads are stopped and joined. The pool must not be running tasks.
+ *
+ * @param p the pool. Must be @b non-null.
+ */
+void csc_threadpool_destroy(cthreadpool* p);
+
+/**
+ * @brief returns the number of threads of the pool, including the calling thread.
+ *
+ * @param p the pool. Must be @b non-null.
+ *
+ * @return the number of threads.
+ */
+size_t csc_threadpool_threads(const cthreadpool* p);
+
+/**
+ * @brief runs @p ntasks tasks on the pool.
+ *
+ * Each task number in the range [0, @p ntasks) is passed to @p fn exactly once. Tasks may run concurrently so
+ * @p fn must synchronize any access to shared state in @p context. Concurrent runs on the same pool are serialized
+ * and @p fn must not run tasks on the pool it is called from.
+ *
+ * All parameters except @p context are expected to be @b non-null.
+ *
+ * @param p the pool.
+ * @param ntasks the number of tasks to run.
+ * @param fn the task callback.
+ * @param context user-defined data passed to every task. Can be @c NULL if unused.
+ *
+ */
+void csc_threadpool_run(cthreadpool* p, size_t ntasks, csc_task fn, void* context);
@@ -0,0 +1,258 @@
+#pragma once
+
+/**
+ * @file ctvector.h
+ * @author Tamer Aly
+ * @date 27 Dec 2018
+ * @brief defines macros that generate type-specialized vectors.
+ *
+ * #cvector stores elements generically and compares them through a #csc_compare callback. That indirection
+ * prevents the compiler from inlining or vectorizing the comparison in hot search loops. The macros in this file
+ * generate a vector specialized for a concrete type at compile time. The generated API mirrors the #cvector API
+ * but elements are stored by value and compared inline.
+ *
+ * Here is some code to get you started:
+ *
+ * @code
+ * // generate a vector of ints called intvec.
+ * // this defines the intvec type and csc_intvec_* functions.
+ * CSC_CVECTOR_DEFINE(int, intvec)
+ *
+ * //
+ * // somewhere in main...
+ * //
+ *
+ * intvec* v = csc_intvec_create();
+ * if (v == NULL) {
+ *      // couldn't create the vector.
+ * }
+ *
+ * for (int i = 0; i < 10; ++i) {
+ *      CSCError e = csc_intvec_add(v, i);
+ *      if (e != E_NOERR) {
+ *          // couldn't add the element.
+ *      }
+ * }
+ *
+ * // the comparison is compiled inline
+ * int* x = csc_intvec_find(v, 5);
+ * if (x == NULL) {
+ *      // element wasn't found.
+ * }
+ *
+ * csc_intvec_destroy(v);
+ * @endcode
+ *
+ * For types that can't be compared with @c ==, such as structs, use #CSC_CVECTOR_DEFINE_EQ and supply
+ * a function or function-like macro that compares two values for equality.
+ *
+ * @see cvector.h
+ */
+
+#include "csc.h"
+#include <assert.h>
+
+/**
+ * @brief equality comparison used by #CSC_CVECTOR_DEFINE for built-in types.
+ *
+ * This is the inline counterpart of the comparison functions declared with #CSC_DECLARE_BUILTIN_CMP.
+ *
+ */
+#define CSC_CVECTOR_BUILTIN_EQ(a, b) ((a) == (b))
+
+/**
+ * @brief generates a vector of built-in @p type named @p name.
+ *
+ * Elements are compared with #CSC_CVECTOR_BUILTIN_EQ.
+ *
+ * @see CSC_CVECTOR_DEFINE_EQ
+ */
+#define CSC_CVECTOR_DEFINE(type, name) CSC_CVECTOR_DEFINE_EQ(type, name, CSC_CVECTOR_BUILTIN_EQ)
+
+/**
+ * @brief generates a vector of @p type named @p name using @p eq to compare elements.
+ *
+ * @p eq is invoked as @c eq(a, b) with two values of @p type and must evaluate to non-zero if they are equal.
+ *
+ * The following type and functions are generated. Each mirrors the #cvector function of the same name:
+ *
+ * @code
+ * typedef struct name name;
+ * name* csc_name_create(void);
+ * name* csc_name_create_with_allocator(const csc_allocator* allocator);
+ * void csc_name_destroy(name* v);
+ * CSCError csc_name_add(name* v, type elem);
+ * bool csc_name_rm(name* v, type elem);
+ * CSCError csc_name_rm_at(name* v, size_t idx, type* out);
+ * type* csc_name_find(const name* v, type elem);
+ * type* csc_name_at(const name* v, size_t idx);
+ * size_t csc_name_size(const name* v);
+ * size_t csc_name_capacity(const name* v);
+ * bool csc_name_empty(const name* v);
+ * void csc_name_foreach(name* v, csc_foreach fn, void* context);
+ * CSCError csc_name_reserve(name* v, size_t num_elems);
+ * CSCError csc_name_shrink_to_fit(name* v);
+ * @endcode
+ *
+ * Unlike #cvector, the removal functions can't return the removed element as a pointer. Instead, @c csc_name_rm
+ * returns @c true if the element was removed and @c csc_name_rm_at optionally copies the removed element into
+ * @p out. As with #cvector, removal swaps the last element into the removed element's position.
+ *
+ * The vector and its data are allocated through #csc_default_allocator, or through the allocator passed to
+ * @c csc_name_create_with_allocator, which is copied into the vector.
+ *
+ * The structure members are public so hot loops may iterate @c data directly.
+ *
+ */
+#define CSC_CVECTOR_DEFINE_EQ(type, name, eq) \
+typedef struct name { \
+    type* data; \
+    size_t size; \
+    size_t capacity; \
+    csc_allocator allocator; \
+} name; \
+\
+static inline name* csc_##name##_create_with_allocator(const csc_allocator* allocator) \
+{ \
+    assert(allocator != NULL); \
+    name* v = allocator->alloc(sizeof(name), allocator->context); \
+    if (v != NULL) { \
+        v->data = NULL; \
+        v->size = 0; \
+        v->capacity = 0; \
+        v->allocator = *allocator; \
+    } \
+    return v; \
+} \
+\
+static inline name* csc_##name##_create(void) \
+{ \
+    return csc_##name##_create_with_allocator(csc_default_allocator()); \
+} \
+\
+static inline void csc_##name##_destroy(name* v) \
+{ \
+    assert(v != NULL); \
+    const csc_allocator a = v->allocator; \
+    a.free(v->data, v->capacity * sizeof(type), a.context); \
+    a.free(v, sizeof(name), a.context); \
+} \
+\
+static inline size_t csc_##name##_size(const name* v) \
+{ \
+    assert(v != NULL); \
+    return v->size; \
+} \
+\
+static inline size_t csc_##name##_capacity(const name* v) \
+{ \
+    assert(v != NULL); \
+    return v->capacity; \
+} \
+\
+static inline bool csc_##name##_empty(const name* v) \
+{ \
+    assert(v != NULL); \
+    return v->size == 0; \
+} \
+\
+static inline CSCError csc_##name##_reserve(name* v, size_t num_elems) \
+{ \
+    assert(v != NULL); \
+    if (num_elems < v->size) { \
+        return E_INVALIDOPERATION; \
+    } \
+    const csc_allocator* a = &(v->allocator); \
+    if (num_elems == 0) { \
+        a->free(v->data, v->capacity * sizeof(type), a->context); \
+        v->data = NULL; \
+        v->capacity = 0; \
+        return E_NOERR; \
+    } \
+    type* data = v->data == NULL ? a->alloc(num_elems * sizeof(type), a->context) \
+                                 : a->realloc(v->data, v->capacity * sizeof(type), num_elems * sizeof(type), a->context); \
+    if (data == NULL) { \
+        return E_OUTOFMEM; \
+    } \
+    v->data = data; \
+    v->capacity = num_elems; \
+    return E_NOERR; \
+} \
+\
+static inline CSCError csc_##name##_shrink_to_fit(name* v) \
+{ \
+    assert(v != NULL); \
+    return csc_##name##_reserve(v, v->size); \
+} \
+\
+static inline CSCError csc_##name##_add(name* v, type elem) \
+{ \
+    assert(v != NULL); \
+    if (v->size >= v->capacity) { \
+        size_t step = v->capacity / 2; \
+        if (step == 0) { \
+            step = 1; \
+        } \
+        const size_t new_capacity = v->capacity == 0 ? 10 : v->capacity + step; \
+        CSCError e = csc_##name##_reserve(v, new_capacity); \
+        if (e != E_NOERR) { \
+            return e; \
+        } \
+    } \
+    v->data[v->size] = elem; \
+    ++v->size; \
+    return E_NOERR; \
+} \
+\
+static inline type* csc_##name##_at(const name* v, size_t idx) \
+{ \
+    assert(v != NULL); \
+    if (idx < v->size) { \
+        return &(v->data[idx]); \
+    } \
+    return NULL; \
+} \
+\
+static inline type* csc_##name##_find(const name* v, type elem) \
+{ \
+    assert(v != NULL); \
+    for (size_t i = 0; i < v->size; ++i) { \
+        if (eq(v->data[i], elem)) { \
+            return &(v->data[i]); \
+        } \
+    } \
+    return NULL; \
+} \
+\
+static inline CSCError csc_##name##_rm_at(name* v, size_t idx, type* out) \
+{ \
+    assert(v != NULL); \
+    if (idx >= v->size) { \
+        return E_OUTOFRANGE; \
+    } \
+    if (out != NULL) { \
+        *out = v->data[idx]; \
+    } \
+    v->data[idx] = v->data[v->size - 1]; \
+    --v->size; \
+    return E_NOERR; \
+} \
+\
+static inline bool csc_##name##_rm(name* v, type elem) \
+{ \
+    assert(v != NULL); \
+    type* found = csc_##name##_find(v, elem); \
+    if (found == NULL) { \
+        return false; \
+    } \
+    csc_##name##_rm_at(v, (size_t)(found - v->data), NULL); \
+    return true; \
+} \
+\
+static inline void csc_##name##_foreach(name* v, csc_foreach fn, void* context) \
+{ \
+    assert(v != NULL); \
+    for (size_t i = 0; i < v->size; ++i) { \
+        fn(&(v->data[i]), context); \
+    } \
+}
@@ -6,18 +6,887 @@
  *
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "cvector.h"
 #include <assert.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #define CSC_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef CSC_X86_SIMD
+    #include <immintrin.h>
+#endif
+
+struct cvector {
+    char* data; /**< The internal data store of the vector. Holds either @c void* elements or packed inline elements. */
+    size_t size; /**< The number of elements currently in the vector. */
+    size_t capacity; /**< The number of elements the vector is capable of storing before needing to resize. */
+    size_t elem_size; /**< The size in bytes of a single slot in @c cvector#data. */
+    bool by_value; /**< If @c true, elements are stored inline by value. Otherwise, @c void* elements are stored. */
+    csc_allocator allocator; /**< The allocator used for the vector and its data. */
+    csc_cvector_growth growth; /**< The policy used to grow @c cvector#capacity. */
+    size_t small_capacity; /**< The number of slots in the inline buffer following the vector or 0 if there is none. */
+    bool mapped; /**< If @c true, @c cvector#data lives in a shared file mapping right after a #_map_header. */
+    int fd; /**< The file backing a mapped vector. */
+};
+
+/**
+ * @brief the header at the start of a file backing a mapped vector.
+ * 
+ * The fields have fixed widths so the layout doesn't depend on the platform's @c size_t.
+ * The elements follow the header immediately and the file holds exactly @c capacity elements.
+ */
+typedef struct _map_header {
+    char magic[8]; /**< Always #CSC_MAP_MAGIC. */
+    uint32_t version; /**< The layout version. Always #CSC_MAP_VERSION. */
+    uint32_t reserved; /**< Unused. Always 0. */
+    uint64_t elem_size; /**< The size of a single element in bytes. */
+    uint64_t size; /**< The number of elements as of the last sync. */
+} _map_header;
+
+#define CSC_MAP_MAGIC "CSCVEC\0"
+#define CSC_MAP_VERSION 1
+
+static const csc_cvector_growth _default_growth = {
+    .initial = 10,
+    .factor_percent = 150,
+    .min_step = 0,
+    .page_size = 0
+};
+
+// returns the address of the slot at the index.
+static char* _slot(const cvector* v, size_t idx)
+{
+    return v->data + (idx * v->elem_size);
+}
+
+// returns the element as seen by the user: the slot itself for inline storage or the stored pointer otherwise.
+static void* _elem(const cvector* v, size_t idx)
+{
+    char* slot = _slot(v, idx);
+    if (v->by_value) {
+        return slot;
+    }
+    return *(void**)slot;
+}
+
+// writes the element into the slot at the index.
+static void _store(cvector* v, size_t idx, void* elem)
+{
+    if (v->by_value) {
+        memcpy(_slot(v, idx), elem, v->elem_size);
+    } else {
+        *(void**)_slot(v, idx) = elem;
+    }
+}
+
+// swaps two distinct, non-overlapping blocks of memory of n bytes.
+static void _swap_bytes(char* a, char* b, size_t n)
+{
+    // fast paths for the common element sizes. memcpy is used to sidestep alignment and aliasing issues.
+    if (n == sizeof(uint64_t)) {
+        uint64_t x, y;
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        memcpy(a, &y, sizeof(y));
+        memcpy(b, &x, sizeof(x));
+        return;
+    } else if (n == sizeof(uint32_t)) {
+        uint32_t x, y;
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        memcpy(a, &y, sizeof(y));
+        memcpy(b, &x, sizeof(x));
+        return;
+    }
+
+    // swap through a small buffer so arbitrarily sized elements don't require an allocation.
+    char tmp[64];
+    while (n > 0) {
+        const size_t chunk = n < sizeof(tmp) ? n : sizeof(tmp);
+        memcpy(tmp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, tmp, chunk);
+        a += chunk;
+        b += chunk;
+        n -= chunk;
+    }
+}
+
+// swaps the contents of two distinct slots.
+static void _swap_slots(cvector* v, size_t i, size_t j)
+{
+    _swap_bytes(_slot(v, i), _slot(v, j), v->elem_size);
+}
+
+// removes the element at the index by swapping it to the back of the vector.
+// for inline storage, the returned pointer refers to the (now unused) last slot.
+static void* _rm_at(cvector* v, size_t idx)
+{
+    if (idx != v->size - 1) {
+        _swap_slots(v, idx, v->size - 1);
+    }
+    --v->size;
+
+    return _elem(v, v->size);
+}
+
+// grows the capacity geometrically so that it can hold at least the requested number of elements.
+static CSCError _grow(cvector* v, size_t min_capacity)
+{
+    const csc_cvector_growth* g = &(v->growth);
+    const size_t max_capacity = SIZE_MAX / v->elem_size;
+
+    size_t new_capacity = g->initial;
+    if (v->capacity != 0) {
+        size_t step = (v->capacity / 100) * (g->factor_percent - 100)
+            + ((v->capacity % 100) * (g->factor_percent - 100)) / 100;
+        if (step < g->min_step) {
+            step = g->min_step;
+        }
+        if (step == 0) {
+            step = 1;
+        }
+        new_capacity = step > max_capacity - v->capacity ? max_capacity : v->capacity + step;
+    }
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+    if (new_capacity > max_capacity) {
+        return E_OUTOFMEM;
+    }
+
+    // round large buffers up to whole pages so the allocator can grow them by remapping rather than copying.
+    if (g->page_size != 0) {
+        const size_t bytes = new_capacity * v->elem_size;
+        if (bytes >= g->page_size && bytes <= SIZE_MAX - g->page_size) {
+            const size_t rounded = ((bytes + g->page_size - 1) / g->page_size) * g->page_size;
+            new_capacity = rounded / v->elem_size;
+        }
+    }
+
+    return csc_cvector_reserve(v, new_capacity);
+}
+
+static size_t _find_idx(const cvector* v, const void* elem, csc_compare cmp)
+{
+    for (size_t i = 0; i < v->size; ++i) {
+        if (cmp(_elem(v, i), elem) == 0) {
+            return i;
+        }
+    }
+    return v->size;
+}
+
+static size_t _find_int_scalar(const int* data, size_t n, int key)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#ifdef CSC_X86_SIMD
+
+// compares 16 keys per iteration using four 128-bit comparisons.
+__attribute__((target("sse2")))
+static size_t _find_int_sse2(const int* data, size_t n, int key)
+{
+    const __m128i k = _mm_set1_epi32(key);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), k);
+        const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 4)), k);
+        const __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 8)), k);
+        const __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 12)), k);
+        const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(any) != 0) {
+            // each matching 32 bit lane sets 4 bits in the byte mask.
+            const unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(a))
+                | ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(b)) << 4)
+                | ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(c)) << 8)
+                | ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(d)) << 12);
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + _find_int_scalar(data + i, n - i, key);
+}
+
+// compares 16 keys per iteration using two 256-bit comparisons.
+__attribute__((target("avx2")))
+static size_t _find_int_avx2(const int* data, size_t n, int key)
+{
+    const __m256i k = _mm256_set1_epi32(key);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), k);
+        const __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 8)), k);
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+            const unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(a))
+                | ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + _find_int_scalar(data + i, n - i, key);
+}
+
+#endif
+
+// returns the index of the first occurrence of the key or n if it doesn't exist.
+static size_t _find_int(const int* data, size_t n, int key)
+{
+#ifdef CSC_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return _find_int_avx2(data, n, key);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return _find_int_sse2(data, n, key);
+    }
+#endif
+    return _find_int_scalar(data, n, key);
+}
+
+/*
+ * Introsort: quicksort with median-of-three pivots that falls back to heapsort when the recursion gets too deep
+ * and finishes small partitions with insertion sort. Works on the slots of the vector directly.
+ */
+
+// partitions at or below this size are insertion sorted.
+#define CSC_INSERTION_SORT_THRESHOLD 16
+
+typedef struct _sorter {
+    char* base; /**< The first slot of the vector. */
+    size_t width; /**< The size of a slot. */
+    bool by_value; /**< Whether slots hold the elements themselves or pointers to them. */
+    csc_compare cmp;
+} _sorter;
+
+static char* _sort_slot(const _sorter* s, size_t i)
+{
+    return s->base + (i * s->width);
+}
+
+static bool _sort_less(const _sorter* s, const char* a, const char* b)
+{
+    if (s->by_value) {
+        return s->cmp(a, b) < 0;
+    }
+    return s->cmp(*(void* const*)a, *(void* const*)b) < 0;
+}
+
+static void _insertion_sort(const _sorter* s, size_t lo, size_t hi)
+{
+    char* first = _sort_slot(s, lo);
+    char* end = _sort_slot(s, hi);
+    for (char* i = first + s->width; i < end; i += s->width) {
+        for (char* j = i; j > first && _sort_less(s, j, j - s->width); j -= s->width) {
+            _swap_bytes(j, j - s->width, s->width);
+        }
+    }
+}
+
+static void _sift_down(const _sorter* s, char* heap, size_t root, size_t n)
+{
+    while (true) {
+        size_t child = (2 * root) + 1;
+        if (child >= n) {
+            return;
+        }
+        char* c = heap + (child * s->width);
+        if (child + 1 < n && _sort_less(s, c, c + s->width)) {
+            ++child;
+            c += s->width;
+        }
+        char* r = heap + (root * s->width);
+        if (!_sort_less(s, r, c)) {
+            return;
+        }
+        _swap_bytes(r, c, s->width);
+        root = child;
+    }
+}
+
+static void _heap_sort(const _sorter* s, size_t lo, size_t hi)
+{
+    char* heap = _sort_slot(s, lo);
+    const size_t n = hi - lo;
+    for (size_t i = n / 2; i > 0; --i) {
+        _sift_down(s, heap, i - 1, n);
+    }
+    for (size_t end = n - 1; end > 0; --end) {
+        _swap_bytes(heap, heap + (end * s->width), s->width);
+        _sift_down(s, heap, 0, end);
+    }
+}
+
+// partitions [lo, hi) around a median-of-three pivot and returns the pivot's final position.
+static size_t _partition(const _sorter* s, size_t lo, size_t hi)
+{
+    const size_t w = s->width;
+    char* first = _sort_slot(s, lo);
+    char* mid = _sort_slot(s, lo + ((hi - lo) / 2));
+    char* last = _sort_slot(s, hi - 1);
+
+    // order the three samples so that first <= mid <= last. These act as sentinels for the scans below.
+    if (_sort_less(s, mid, first)) {
+        _swap_bytes(mid, first, w);
+    }
+    if (_sort_less(s, last, mid)) {
+        _swap_bytes(last, mid, w);
+        if (_sort_less(s, mid, first)) {
+            _swap_bytes(mid, first, w);
+        }
+    }
+
+    // park the pivot next to the upper sentinel.
+    char* pivot = last - w;
+    _swap_bytes(mid, pivot, w);
+
+    char* i = first;
+    char* j = pivot;
+    while (true) {
+        do {
+            i += w;
+        } while (_sort_less(s, i, pivot));
+        do {
+            j -= w;
+        } while (_sort_less(s, pivot, j));
+        if (i >= j) {
+            break;
+        }
+        _swap_bytes(i, j, w);
+    }
+    _swap_bytes(i, pivot, w);
+
+    return lo + ((size_t)(i - first) / w);
+}
+
+static void _introsort(const _sorter* s, size_t lo, size_t hi, size_t depth)
+{
+    while (hi - lo > CSC_INSERTION_SORT_THRESHOLD) {
+        if (depth == 0) {
+            _heap_sort(s, lo, hi);
+            return;
+        }
+        --depth;
+
+        // recurse into the smaller partition and loop on the larger one to bound the stack depth.
+        const size_t p = _partition(s, lo, hi);
+        if (p - lo < hi - (p + 1)) {
+            _introsort(s, lo, p, depth);
+            lo = p + 1;
+        } else {
+            _introsort(s, p + 1, hi, depth);
+            hi = p;
+        }
+    }
+    _insertion_sort(s, lo, hi);
+}
+
+// returns the introsort depth limit for n elements: 2 * log2(n).
+static size_t _introsort_depth(size_t n)
+{
+    size_t depth = 0;
+    for (; n > 1; n >>= 1) {
+        depth += 2;
+    }
+    return depth;
+}
+
+/*
+ * Parallel algorithms. The vector is split into contiguous chunks which are handed out as tasks to the worker pool.
+ */
+
+// vectors smaller than this are sorted serially since the threading overhead outweighs the gain.
+#define CSC_PARALLEL_SORT_THRESHOLD 4096
+
+// returns the number of chunks to split n elements into: one per thread of the pool.
+static size_t _parallel_chunks(const cthreadpool* p, size_t n)
+{
+    const size_t nthreads = csc_threadpool_threads(p);
+    return nthreads < n ? nthreads : n;
+}
+
+typedef struct _foreach_task {
+    const cvector* v;
+    csc_foreach fn;
+    void* context;
+    size_t nchunks;
+} _foreach_task;
+
+static void _foreach_chunk(size_t task, void* context)
+{
+    const _foreach_task* t = (const _foreach_task*)context;
+    const size_t lo = (task * t->v->size) / t->nchunks;
+    const size_t hi = ((task + 1) * t->v->size) / t->nchunks;
+    for (size_t i = lo; i < hi; ++i) {
+        t->fn(_elem(t->v, i), t->context);
+    }
+}
+
+typedef struct _sort_task {
+    const _sorter* s;
+    size_t* bounds; /**< Run i occupies [bounds[i], bounds[i + 1]). */
+    size_t nruns;
+    char* src; /**< The buffer holding the runs to merge. */
+    char* dst; /**< The buffer to merge the runs into. */
+} _sort_task;
+
+static void _sort_chunk(size_t task, void* context)
+{
+    const _sort_task* t = (const _sort_task*)context;
+    const size_t lo = t->bounds[task];
+    const size_t hi = t->bounds[task + 1];
+    _introsort(t->s, lo, hi, _introsort_depth(hi - lo));
+}
+
+// merges runs 2 * task and 2 * task + 1 from the source into the destination buffer.
+static void _merge_runs(size_t task, void* context)
+{
+    const _sort_task* t = (const _sort_task*)context;
+    const _sorter* s = t->s;
+    const size_t w = s->width;
+
+    const size_t run = 2 * task;
+    const size_t lo = t->bounds[run];
+    const size_t mid = t->bounds[run + 1];
+    const size_t hi = run + 2 <= t->nruns ? t->bounds[run + 2] : mid; // a trailing odd run is copied as-is.
+
+    const char* a = t->src + (lo * w);
+    const char* a_end = t->src + (mid * w);
+    const char* b = a_end;
+    const char* b_end = t->src + (hi * w);
+    char* out = t->dst + (lo * w);
+
+    while (a < a_end && b < b_end) {
+        if (_sort_less(s, b, a)) {
+            memcpy(out, b, w);
+            b += w;
+        } else {
+            memcpy(out, a, w);
+            a += w;
+        }
+        out += w;
+    }
+    memcpy(out, a, (size_t)(a_end - a));
+    out += a_end - a;
+    memcpy(out, b, (size_t)(b_end - b));
+}
+
+// radix sort is slower than introsort for small inputs due to its fixed histogram cost.
+#define CSC_RADIX_SORT_THRESHOLD 256
+
+// LSD radix sort of ints, one byte per pass. tmp must hold n ints.
+static void _radix_sort_int(int* data, int* tmp, size_t n)
+{
+    size_t counts[sizeof(int)][256] = {{0}};
+
+    // flipping the sign bit makes the two's complement keys sort correctly as unsigned.
+    const unsigned sign = 1u << ((sizeof(int) * CHAR_BIT) - 1);
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned key = (unsigned)data[i] ^ sign;
+        for (size_t b = 0; b < sizeof(int); ++b) {
+            ++counts[b][(key >> (b * 8)) & 0xFF];
+        }
+    }
+
+    int* src = data;
+    int* dst = tmp;
+    for (size_t b = 0; b < sizeof(int); ++b) {
+        const unsigned shift = (unsigned)(b * 8);
+
+        // skip the pass if every key has the same byte here.
+        if (counts[b][(((unsigned)src[0] ^ sign) >> shift) & 0xFF] == n) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            const size_t c = counts[b][d];
+            counts[b][d] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const unsigned key = (unsigned)src[i] ^ sign;
+            dst[counts[b][(key >> shift) & 0xFF]++] = src[i];
+        }
+
+        int* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != data) {
+        memcpy(data, src, n * sizeof(int));
+    }
+}
+
+#ifdef CSC_MMAP
+
+static _map_header* _map_base(const cvector* v)
+{
+    return (_map_header*)(v->data - sizeof(_map_header));
+}
+
+// returns the length of a mapping holding the header and capacity elements.
+static size_t _map_length(size_t elem_size, size_t capacity)
+{
+    return sizeof(_map_header) + (capacity * elem_size);
+}
+
+// maps length bytes of the file and returns the address of its header or NULL on failure.
+static _map_header* _map(int fd, size_t length)
+{
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return base == MAP_FAILED ? NULL : base;
+}
+
+// resizes the file to hold num_elems elements and remaps it.
+static CSCError _map_reserve(cvector* v, size_t num_elems)
+{
+    if (num_elems > (SIZE_MAX - sizeof(_map_header)) / v->elem_size) {
+        return E_OUTOFMEM;
+    }
+
+    const size_t old_length = _map_length(v->elem_size, v->capacity);
+    const size_t new_length = _map_length(v->elem_size, num_elems);
+    if (new_length > old_length && ftruncate(v->fd, (off_t)new_length) != 0) {
+        return E_IO;
+    }
+
+    // the file is extended in place so mapping it again never copies the elements.
+    _map_header* h = _map(v->fd, new_length);
+    if (h == NULL) {
+        return E_OUTOFMEM;
+    }
+    munmap(_map_base(v), old_length);
+    if (new_length < old_length) {
+        // a failed truncation only leaves unused capacity at the end of the file.
+        const int truncated = ftruncate(v->fd, (off_t)new_length);
+        CSC_UNUSED(truncated);
+    }
+
+    v->data = (char*)(h + 1);
+    v->capacity = num_elems;
+
+    return E_NOERR;
+}
+
+// checks the header of an existing file and returns the number of elements the file can hold.
+static CSCError _map_validate(const _map_header* h, size_t length, size_t elem_size, size_t* capacity)
+{
+    if (memcmp(h->magic, CSC_MAP_MAGIC, sizeof(h->magic)) != 0 || h->version != CSC_MAP_VERSION
+        || h->elem_size != elem_size) {
+        return E_INVALIDOPERATION;
+    }
+
+    const size_t bytes = length - sizeof(_map_header);
+    if (bytes % elem_size != 0 || h->size > bytes / elem_size) {
+        return E_INVALIDOPERATION;
+    }
+    *capacity = bytes / elem_size;
+
+    return E_NOERR;
+}
+
+// opens or creates the file at path and maps it. On success the vector owns the file descriptor.
+static CSCError _map_open(cvector* v, const char* path)
+{
+    const int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return E_IO;
+    }
+
+    CSCError e = E_NOERR;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        e = E_IO;
+    } else if (st.st_size == 0) {
+        // a new file only holds the header until the first element is added.
+        if (ftruncate(fd, (off_t)sizeof(_map_header)) != 0) {
+            e = E_IO;
+        }
+    } else if ((size_t)st.st_size < sizeof(_map_header)) {
+        e = E_INVALIDOPERATION;
+    }
+    if (e != E_NOERR) {
+        close(fd);
+        return e;
+    }
+
+    const bool created = st.st_size == 0;
+    const size_t length = created ? sizeof(_map_header) : (size_t)st.st_size;
+    _map_header* h = _map(fd, length);
+    if (h == NULL) {
+        close(fd);
+        return E_OUTOFMEM;
+    }
+
+    size_t capacity = 0;
+    if (created) {
+        memcpy(h->magic, CSC_MAP_MAGIC, sizeof(h->magic));
+        h->version = CSC_MAP_VERSION;
+        h->reserved = 0;
+        h->elem_size = v->elem_size;
+        h->size = 0;
+    } else {
+        e = _map_validate(h, length, v->elem_size, &capacity);
+        if (e != E_NOERR) {
+            munmap(h, length);
+            close(fd);
+            return e;
+        }
+    }
+
+    v->mapped = true;
+    v->fd = fd;
+    v->data = (char*)(h + 1);
+    v->size = (size_t)h->size;
+    v->capacity = capacity;
+
+    return E_NOERR;
+}
+
+// writes the element count to the header and flushes the mapping to the file.
+static CSCError _map_sync(cvector* v)
+{
+    _map_header* h = _map_base(v);
+    h->size = v->size;
+    if (msync(h, _map_length(v->elem_size, v->capacity), MS_SYNC) != 0) {
+        return E_IO;
+    }
+    return E_NOERR;
+}
+
+static void _map_close(cvector* v)
+{
+    _map_header* h = _map_base(v);
+    h->size = v->size;
+    munmap(h, _map_length(v->elem_size, v->capacity));
+    close(v->fd);
+}
+
+#endif
+
+// returns the offset of the inline buffer of a small vector, rounded up so any element type is suitably aligned.
+static size_t _small_offset(void)
+{
+    return (sizeof(cvector) + 15) & ~(size_t)15;
+}
+
+static char* _small_buffer(const cvector* v)
+{
+    return (char*)v + _small_offset();
+}
+
+// returns the size of the block holding the vector and its inline buffer, if any.
+static size_t _block_size(size_t elem_size, size_t small_capacity)
+{
+    if (small_capacity == 0) {
+        return sizeof(cvector);
+    }
+    return _small_offset() + (small_capacity * elem_size);
+}
+
+// reserves storage for a small vector, moving the elements between the inline buffer and the heap as needed.
+static CSCError _small_reserve(cvector* v, size_t num_elems)
+{
+    const csc_allocator* a = &(v->allocator);
+    char* buffer = _small_buffer(v);
+    const size_t old_size = v->capacity * v->elem_size;
+
+    if (num_elems <= v->small_capacity) {
+        if (v->data != buffer) {
+            memcpy(buffer, v->data, v->size * v->elem_size);
+            a->free(v->data, old_size, a->context);
+            v->data = buffer;
+        }
+        v->capacity = v->small_capacity;
+        return E_NOERR;
+    }
+
+    char* data = NULL;
+    if (v->data == buffer) {
+        data = a->alloc(num_elems * v->elem_size, a->context);
+        if (data != NULL) {
+            memcpy(data, buffer, v->size * v->elem_size);
+        }
+    } else {
+        data = a->realloc(v->data, old_size, num_elems * v->elem_size, a->context);
+    }
+    if (data == NULL) {
+        return E_OUTOFMEM;
+    }
+
+    v->data = data;
+    v->capacity = num_elems;
+
+    return E_NOERR;
+}
+
+// creates a vector whose first small_capacity slots are allocated in the same block as the vector itself.
+static cvector* _create(size_t elem_size, bool by_value, size_t small_capacity, const csc_allocator* allocator)
+{
+    assert(allocator != NULL);
+    if (small_capacity > (SIZE_MAX - _small_offset()) / elem_size) {
+        return NULL;
+    }
+
+    cvector* v = allocator->alloc(_block_size(elem_size, small_capacity), allocator->context);
+    if (v != NULL) {
+        memset(v, 0, sizeof(*v));
+        v->elem_size = elem_size;
+        v->by_value = by_value;
+        v->allocator = *allocator;
+        v->growth = _default_growth;
+        v->small_capacity = small_capacity;
+        if (small_capacity != 0) {
+            v->data = _small_buffer(v);
+            v->capacity = small_capacity;
+        }
+    }
+    return v;
+}
+
+cvector* csc_cvector_create()
+{
+    return _create(sizeof(void*), false, 0, csc_default_allocator());
+}
+
+cvector* csc_cvector_create_with_allocator(const csc_allocator* allocator)
+{
+    return _create(sizeof(void*), false, 0, allocator);
+}
 
-struct cvector {
-    void** data; /**< The internal data store of the vector. */
-    size_t size; /**< The number of elements currently in the vector. */
-    size_t capacity; /**< The number of elements the vector is capable of storing before needing to resize. */
-};
+cvector* csc_cvector_create_with_capacity(size_t n)
+{
+    return csc_cvector_create_with_capacity_with_allocator(n, csc_default_allocator());
+}
 
-cvector* csc_cvector_create()
+cvector* csc_cvector_create_with_capacity_with_allocator(size_t n, const csc_allocator* allocator)
+{
+    cvector* v = csc_cvector_create_with_allocator(allocator);
+    if (v == NULL) {
+        return NULL;
+    }
+
+    if (csc_cvector_reserve(v, n) != E_NOERR) {
+        csc_cvector_destroy(v);
+        return NULL;
+    }
+    return v;
+}
+
+cvector* csc_cvector_create_sized(size_t elem_size)
+{
+    return csc_cvector_create_sized_with_allocator(elem_size, csc_default_allocator());
+}
+
+cvector* csc_cvector_create_sized_with_allocator(size_t elem_size, const csc_allocator* allocator)
+{
+    // zero sized elements are not allowed.
+    if (elem_size == 0) {
+        return NULL;
+    }
+    return _create(elem_size, true, 0, allocator);
+}
+
+cvector* csc_cvector_create_with_growth(const csc_cvector_growth* growth)
+{
+    cvector* v = csc_cvector_create();
+    if (v != NULL && csc_cvector_set_growth(v, growth) != E_NOERR) {
+        csc_cvector_destroy(v);
+        return NULL;
+    }
+    return v;
+}
+
+cvector* csc_cvector_create_sized_with_growth(size_t elem_size, const csc_cvector_growth* growth)
+{
+    cvector* v = csc_cvector_create_sized(elem_size);
+    if (v != NULL && csc_cvector_set_growth(v, growth) != E_NOERR) {
+        csc_cvector_destroy(v);
+        return NULL;
+    }
+    return v;
+}
+
+cvector* csc_cvector_create_small(size_t n)
+{
+    return csc_cvector_create_small_with_allocator(n, csc_default_allocator());
+}
+
+cvector* csc_cvector_create_small_with_allocator(size_t n, const csc_allocator* allocator)
+{
+    return _create(sizeof(void*), false, n, allocator);
+}
+
+cvector* csc_cvector_create_sized_small(size_t elem_size, size_t n)
+{
+    return csc_cvector_create_sized_small_with_allocator(elem_size, n, csc_default_allocator());
+}
+
+cvector* csc_cvector_create_sized_small_with_allocator(size_t elem_size, size_t n, const csc_allocator* allocator)
+{
+    // zero sized elements are not allowed.
+    if (elem_size == 0) {
+        return NULL;
+    }
+    return _create(elem_size, true, n, allocator);
+}
+
+cvector* csc_cvector_create_from(void* const* array, size_t n)
 {
-    return calloc(1, sizeof(cvector));
+    return csc_cvector_create_from_with_allocator(array, n, csc_default_allocator());
+}
+
+cvector* csc_cvector_create_from_with_allocator(void* const* array, size_t n, const csc_allocator* allocator)
+{
+    assert(array != NULL || n == 0);
+    cvector* v = csc_cvector_create_with_allocator(allocator);
+    if (v == NULL) {
+        return NULL;
+    }
+
+    if (csc_cvector_add_n(v, array, n) != E_NOERR) {
+        csc_cvector_destroy(v);
+        return NULL;
+    }
+    return v;
+}
+
+cvector* csc_cvector_adopt(void** buffer, size_t n, size_t cap)
+{
+    return csc_cvector_adopt_with_allocator(buffer, n, cap, csc_default_allocator());
+}
+
+cvector* csc_cvector_adopt_with_allocator(void** buffer, size_t n, size_t cap, const csc_allocator* allocator)
+{
+    if (n > cap || (buffer == NULL && cap != 0)) {
+        return NULL;
+    }
+
+    cvector* v = csc_cvector_create_with_allocator(allocator);
+    if (v != NULL) {
+        v->data = (char*)buffer;
+        v->size = n;
+        v->capacity = cap;
+    }
+    return v;
 }
 
 size_t csc_cvector_size(const cvector* v)
@@ -32,10 +901,76 @@ size_t csc_cvector_capacity(const cvector* v)
     return v->capacity;
 }
 
+CSCError csc_cvector_set_growth(cvector* v, const csc_cvector_growth* growth)
+{
+    assert(v != NULL);
+    assert(growth != NULL);
+    if (growth->initial == 0 || growth->factor_percent < 100) {
+        return E_INVALIDOPERATION;
+    }
+
+    v->growth = *growth;
+    return E_NOERR;
+}
+
+size_t csc_cvector_elem_size(const cvector* v)
+{
+    assert(v != NULL);
+    return v->by_value ? v->elem_size : 0;
+}
+
+cvector* csc_cvector_open_mapped(const char* path, size_t elem_size, CSCError* e)
+{
+    assert(path != NULL);
+    CSCError err = E_INVALIDOPERATION;
+    cvector* v = NULL;
+
+#ifdef CSC_MMAP
+    // zero sized elements are not allowed.
+    if (elem_size != 0) {
+        v = _create(elem_size, true, 0, csc_default_allocator());
+        err = v == NULL ? E_OUTOFMEM : _map_open(v, path);
+        if (v != NULL && err != E_NOERR) {
+            csc_cvector_destroy(v);
+            v = NULL;
+        }
+    }
+#else
+    CSC_UNUSED(elem_size);
+#endif
+
+    if (e != NULL) {
+        *e = err;
+    }
+    return v;
+}
+
+CSCError csc_cvector_sync(cvector* v)
+{
+    assert(v != NULL);
+#ifdef CSC_MMAP
+    if (v->mapped) {
+        return _map_sync(v);
+    }
+#endif
+    return E_INVALIDOPERATION;
+}
+
 void csc_cvector_destroy(cvector* v)
 {
     assert(v != NULL);
-    free(v);
+    const csc_allocator a = v->allocator;
+#ifdef CSC_MMAP
+    if (v->mapped) {
+        _map_close(v);
+        v->data = NULL;
+        v->capacity = 0;
+    }
+#endif
+    if (v->small_capacity == 0 || v->data != _small_buffer(v)) {
+        a.free(v->data, v->capacity * v->elem_size, a.context);
+    }
+    a.free(v, _block_size(v->elem_size, v->small_capacity), a.context);
 }
 
 void csc_cvector_foreach(cvector* v, csc_foreach fn, void* context)
@@ -46,31 +981,84 @@ void csc_cvector_foreach(cvector* v, csc_foreach fn, void* context)
     }
 
     for (size_t i = 0; i < v->size; ++i) {
-        fn(v->data[i], context);
+        fn(_elem(v, i), context);
     }
 }
 
+csc_cvector_iter csc_cvector_iter_begin(const cvector* v)
+{
+    assert(v != NULL);
+    csc_cvector_iter it;
+    it.pos = v->data;
+    it.end = v->data == NULL ? NULL : _slot(v, v->size);
+    it.stride = v->elem_size;
+    it.by_value = v->by_value;
+    return it;
+}
+
 CSCError csc_cvector_add(cvector* v, void* elem)
 {
     assert(v != NULL);
     if (v->size >= v->capacity) {
-        const size_t new_capacity = v->capacity == 0 ? 10 : v->capacity * 1.5;
-        CSCError e = csc_cvector_reserve(v, new_capacity);
+        CSCError e = _grow(v, v->size + 1);
         if (e != E_NOERR) {
             return e;
         }
     }
-    v->data[v->size] = elem;
+
+    _store(v, v->size, elem);
+    ++v->size;
+
+    return E_NOERR;
+}
+
+CSCError csc_cvector_insert(cvector* v, size_t idx, void* elem)
+{
+    assert(v != NULL);
+    if (idx > v->size) {
+        return E_OUTOFRANGE;
+    }
+    if (v->size >= v->capacity) {
+        CSCError e = _grow(v, v->size + 1);
+        if (e != E_NOERR) {
+            return e;
+        }
+    }
+
+    memmove(_slot(v, idx + 1), _slot(v, idx), (v->size - idx) * v->elem_size);
+    _store(v, idx, elem);
     ++v->size;
 
     return E_NOERR;
 }
 
+CSCError csc_cvector_add_n(cvector* v, const void* elems, size_t n)
+{
+    assert(v != NULL);
+    if (n == 0) {
+        return E_NOERR;
+    }
+    assert(elems != NULL);
+
+    if (n > v->capacity - v->size) {
+        CSCError e = _grow(v, v->size + n);
+        if (e != E_NOERR) {
+            return e;
+        }
+    }
+
+    // both storage modes hold elements as a packed array of slots so a single copy suffices.
+    memcpy(_slot(v, v->size), elems, n * v->elem_size);
+    v->size += n;
+
+    return E_NOERR;
+}
+
 void* csc_cvector_at(const cvector* v, size_t idx)
 {
     assert(v != NULL);
     if (idx < v->size) {
-        return v->data[idx];
+        return _elem(v, idx);
     }
     return NULL;
 }
@@ -78,48 +1066,166 @@ void* csc_cvector_at(const cvector* v, size_t idx)
 void* csc_cvector_rm(cvector* v, const void* elem, csc_compare cmp)
 {
     assert(v != NULL);
-    void* ret = csc_cvector_find(v, elem, cmp);
-    if (ret == NULL) {
+    const size_t idx = _find_idx(v, elem, cmp);
+    if (idx == v->size) {
         return NULL; // if the vector is empty or the element isn't there.
     }
 
-    if (v->size > 1) {
-        csc_swap(&ret, &(v->data[v->size - 1]));
-    }
-    --v->size;
-
-    return ret;
+    return _rm_at(v, idx);
 }
 
 void* csc_cvector_rm_at(cvector* v, size_t idx)
 {
     assert(v != NULL);
+    if (idx >= v->size) {
+        return NULL;
+    }
+
+    return _rm_at(v, idx);
+}
 
-    void* ret = csc_cvector_at(v, idx);
-    if (ret == NULL) {
+void* csc_cvector_rm_at_ordered(cvector* v, size_t idx)
+{
+    assert(v != NULL);
+    if (idx >= v->size) {
         return NULL;
     }
 
-    if (v->size > 1) {
-        csc_swap(&ret, &(v->data[v->size - 1]));
+    const size_t last = v->size - 1;
+    if (!v->by_value) {
+        void* ret = _elem(v, idx);
+        memmove(_slot(v, idx), _slot(v, idx + 1), (last - idx) * v->elem_size);
+        --v->size;
+        return ret;
+    }
+
+    // rotate the removed element into the last slot so it remains readable like with csc_cvector_rm_at.
+    char tmp[64];
+    if (v->elem_size <= sizeof(tmp)) {
+        memcpy(tmp, _slot(v, idx), v->elem_size);
+        memmove(_slot(v, idx), _slot(v, idx + 1), (last - idx) * v->elem_size);
+        memcpy(_slot(v, last), tmp, v->elem_size);
+    } else {
+        for (size_t i = idx; i < last; ++i) {
+            _swap_slots(v, i, i + 1);
+        }
     }
     --v->size;
-    
-    return ret;
+
+    return _slot(v, last);
 }
 
-void* csc_cvector_find(const cvector* v, const void* elem, csc_compare cmp)
+CSCError csc_cvector_rm_range(cvector* v, size_t first, size_t last)
+{
+    assert(v != NULL);
+    if (first > last || last > v->size) {
+        return E_OUTOFRANGE;
+    }
+    if (first == last) {
+        return E_NOERR;
+    }
+
+    memmove(_slot(v, first), _slot(v, last), (v->size - last) * v->elem_size);
+    v->size -= last - first;
+
+    return E_NOERR;
+}
+
+size_t csc_cvector_erase_if(cvector* v, csc_predicate pred, void* context)
 {
     assert(v != NULL);
 
+    // compact the kept elements towards the front in a single pass.
+    size_t kept = 0;
     for (size_t i = 0; i < v->size; ++i) {
-        if (cmp(v->data[i], elem) == 0) {
-            return v->data[i];
+        if (pred(_elem(v, i), context)) {
+            continue;
+        }
+        if (kept != i) {
+            memcpy(_slot(v, kept), _slot(v, i), v->elem_size);
         }
+        ++kept;
+    }
+
+    const size_t removed = v->size - kept;
+    v->size = kept;
+
+    return removed;
+}
+
+void* csc_cvector_find(const cvector* v, const void* elem, csc_compare cmp)
+{
+    assert(v != NULL);
+    const size_t idx = _find_idx(v, elem, cmp);
+    if (idx == v->size) {
+        return NULL;
+    }
+    return _elem(v, idx);
+}
+
+// returns the first index whose element is not less than (or, if upper, is greater than) the element.
+// the loop body has no data-dependent branches so the compiler can emit a conditional move.
+static size_t _bound(const cvector* v, const void* elem, csc_compare cmp, bool upper)
+{
+    size_t n = v->size;
+    if (n == 0) {
+        return 0;
+    }
+
+    // the answer always lies in [lo, lo + n].
+    size_t lo = 0;
+    while (n > 1) {
+        const size_t half = n / 2;
+        const int r = cmp(_elem(v, lo + half), elem);
+        lo = (upper ? r <= 0 : r < 0) ? lo + half : lo;
+        n -= half;
+    }
+
+    const int r = cmp(_elem(v, lo), elem);
+    return lo + ((upper ? r <= 0 : r < 0) ? 1 : 0);
+}
+
+size_t csc_cvector_lower_bound(const cvector* v, const void* elem, csc_compare cmp)
+{
+    assert(v != NULL);
+    return _bound(v, elem, cmp, false);
+}
+
+size_t csc_cvector_upper_bound(const cvector* v, const void* elem, csc_compare cmp)
+{
+    assert(v != NULL);
+    return _bound(v, elem, cmp, true);
+}
+
+void* csc_cvector_bsearch(const cvector* v, const void* elem, csc_compare cmp)
+{
+    assert(v != NULL);
+    const size_t idx = _bound(v, elem, cmp, false);
+    if (idx < v->size && cmp(_elem(v, idx), elem) == 0) {
+        return _elem(v, idx);
     }
     return NULL;
 }
 
+int* csc_cvector_find_int(const cvector* v, int key)
+{
+    assert(v != NULL);
+    if (!v->by_value) {
+        return csc_cvector_find(v, &key, csc_cmp_int);
+    }
+
+    if (v->elem_size != sizeof(int) || v->size == 0) {
+        return NULL;
+    }
+
+    int* data = (int*)v->data;
+    const size_t idx = _find_int(data, v->size, key);
+    if (idx == v->size) {
+        return NULL;
+    }
+    return &(data[idx]);
+}
+
 bool csc_cvector_empty(const cvector* v)
 {
     assert(v != NULL);
@@ -133,7 +1239,32 @@ CSCError csc_cvector_reserve(cvector* v, size_t num_elems)
         return E_INVALIDOPERATION; // no information loss allowed
     }
 
-    void** data = realloc(v->data, num_elems * sizeof(*(v->data)));
+#ifdef CSC_MMAP
+    if (v->mapped) {
+        return _map_reserve(v, num_elems);
+    }
+#endif
+    if (v->small_capacity != 0) {
+        return _small_reserve(v, num_elems);
+    }
+
+    const csc_allocator* a = &(v->allocator);
+    const size_t old_size = v->capacity * v->elem_size;
+
+    // realloc with a size of 0 is implementation defined so release the memory explicitly.
+    if (num_elems == 0) {
+        a->free(v->data, old_size, a->context);
+        v->data = NULL;
+        v->capacity = 0;
+        return E_NOERR;
+    }
+
+    char* data = NULL;
+    if (v->data == NULL) {
+        data = a->alloc(num_elems * v->elem_size, a->context);
+    } else {
+        data = a->realloc(v->data, old_size, num_elems * v->elem_size, a->context);
+    }
     if (data == NULL) {
         return E_OUTOFMEM;
     }
@@ -148,4 +1279,134 @@ CSCError csc_cvector_shrink_to_fit(cvector* v)
 {
     assert(v != NULL);
     return csc_cvector_reserve(v, v->size);
-}
\ No newline at end of file
+}
+
+void csc_cvector_sort(cvector* v, csc_compare cmp)
+{
+    assert(v != NULL);
+    if (v->size < 2) {
+        return;
+    }
+
+    const _sorter s = { .base = v->data, .width = v->elem_size, .by_value = v->by_value, .cmp = cmp };
+    _introsort(&s, 0, v->size, _introsort_depth(v->size));
+}
+
+void csc_cvector_parallel_foreach(cvector* v, csc_foreach fn, void* context, size_t nthreads)
+{
+    assert(v != NULL);
+    cthreadpool* p = csc_threadpool_create(nthreads);
+    if (p == NULL) {
+        csc_cvector_foreach(v, fn, context);
+        return;
+    }
+    csc_cvector_parallel_foreach_with_pool(v, fn, context, p);
+    csc_threadpool_destroy(p);
+}
+
+void csc_cvector_parallel_foreach_with_pool(cvector* v, csc_foreach fn, void* context, cthreadpool* p)
+{
+    assert(v != NULL);
+    if (v->size == 0) {
+        return;
+    }
+
+    _foreach_task t = { .v = v, .fn = fn, .context = context, .nchunks = _parallel_chunks(p, v->size) };
+    csc_threadpool_run(p, t.nchunks, _foreach_chunk, &t);
+}
+
+CSCError csc_cvector_parallel_sort(cvector* v, csc_compare cmp, size_t nthreads)
+{
+    assert(v != NULL);
+    if (v->size < CSC_PARALLEL_SORT_THRESHOLD) {
+        csc_cvector_sort(v, cmp);
+        return E_NOERR;
+    }
+
+    cthreadpool* p = csc_threadpool_create(nthreads);
+    if (p == NULL) {
+        csc_cvector_sort(v, cmp);
+        return E_NOERR;
+    }
+    const CSCError e = csc_cvector_parallel_sort_with_pool(v, cmp, p);
+    csc_threadpool_destroy(p);
+    return e;
+}
+
+CSCError csc_cvector_parallel_sort_with_pool(cvector* v, csc_compare cmp, cthreadpool* p)
+{
+    assert(v != NULL);
+    const size_t nchunks = _parallel_chunks(p, v->size);
+    if (nchunks <= 1 || v->size < CSC_PARALLEL_SORT_THRESHOLD) {
+        csc_cvector_sort(v, cmp);
+        return E_NOERR;
+    }
+
+    const csc_allocator* a = &(v->allocator);
+    const size_t bounds_size = (nchunks + 1) * sizeof(size_t);
+    const size_t tmp_size = v->size * v->elem_size;
+    size_t* bounds = a->alloc(bounds_size, a->context);
+    char* tmp = a->alloc(tmp_size, a->context);
+    if (bounds == NULL || tmp == NULL) {
+        a->free(bounds, bounds_size, a->context);
+        a->free(tmp, tmp_size, a->context);
+        return E_OUTOFMEM;
+    }
+    for (size_t i = 0; i <= nchunks; ++i) {
+        bounds[i] = (i * v->size) / nchunks;
+    }
+
+    // sort each chunk independently.
+    const _sorter s = { .base = v->data, .width = v->elem_size, .by_value = v->by_value, .cmp = cmp };
+    _sort_task t = { .s = &s, .bounds = bounds, .nruns = nchunks, .src = v->data, .dst = tmp };
+    csc_threadpool_run(p, nchunks, _sort_chunk, &t);
+
+    // merge pairs of sorted runs in rounds, ping-ponging between the vector and the temporary buffer.
+    while (t.nruns > 1) {
+        const size_t merges = (t.nruns + 1) / 2;
+        csc_threadpool_run(p, merges, _merge_runs, &t);
+
+        // every other boundary survives the round.
+        for (size_t i = 0; i <= merges; ++i) {
+            bounds[i] = bounds[2 * i < t.nruns ? 2 * i : t.nruns];
+        }
+        t.nruns = merges;
+
+        char* swap = t.src;
+        t.src = t.dst;
+        t.dst = swap;
+    }
+
+    if (t.src != v->data) {
+        memcpy(v->data, t.src, v->size * v->elem_size);
+    }
+
+    a->free(tmp, tmp_size, a->context);
+    a->free(bounds, bounds_size, a->context);
+
+    return E_NOERR;
+}
+
+CSCError csc_cvector_sort_int(cvector* v)
+{
+    assert(v != NULL);
+    if (v->by_value && v->elem_size != sizeof(int)) {
+        return E_INVALIDOPERATION;
+    }
+    if (!v->by_value || v->size < CSC_RADIX_SORT_THRESHOLD) {
+        csc_cvector_sort(v, csc_cmp_int);
+        return E_NOERR;
+    }
+
+    const csc_allocator* a = &(v->allocator);
+    const size_t tmp_size = v->size * sizeof(int);
+    int* tmp = a->alloc(tmp_size, a->context);
+    if (tmp == NULL) {
+        return E_OUTOFMEM;
+    }
+
+    _radix_sort_int((int*)v->data, tmp, v->size);
+    a->free(tmp, tmp_size, a->context);
+
+    return E_NOERR;
+}
@@ -76,9 +76,28 @@
  * 
  * @endcode
  * 
+ * A vector can also store its elements inline by value rather than as pointers. This avoids an allocation
+ * per element and keeps the elements contiguous in memory:
+ * 
+ * @code
+ * // create a vector that stores ints by value
+ * cvector* v = csc_cvector_create_sized(sizeof(int));
+ * 
+ * // the element is copied into the vector so a stack variable is fine
+ * int x = 42;
+ * CSCError e = csc_cvector_add(v, &x);
+ * 
+ * // retrieve a pointer to the element's slot in the vector
+ * int* y = (int*) csc_cvector_at(v, 0);
+ * 
+ * // no per-element cleanup required
+ * csc_cvector_destroy(v);
+ * @endcode
+ * 
  */
 
 #include "csc.h"
+#include "cthreadpool.h"
 
 /**
  * @brief implementation of a generic dynamic array.
@@ -89,6 +108,38 @@
  */
 typedef struct cvector cvector;
 
+/**
+ * @brief the policy a #cvector uses to grow its capacity when it runs out of room.
+ * 
+ * When an element is added to a full vector, the new capacity is computed as follows:
+ * 
+ * - An empty vector grows to @c csc_cvector_growth#initial elements.
+ * - Otherwise, the new capacity is @c csc_cvector_growth#factor_percent percent of the current capacity, but at
+ *   least @c csc_cvector_growth#min_step elements more than the current capacity.
+ * - If @c csc_cvector_growth#page_size is not 0 and the resulting buffer is at least one page, the buffer size is
+ *   rounded up to a multiple of @c csc_cvector_growth#page_size bytes.
+ * 
+ * Rounding very large buffers to huge page multiples, such as #CSC_CVECTOR_HUGE_PAGE_SIZE, lets allocators that
+ * serve large blocks with @c mmap, like glibc's @c malloc, resize them with @c mremap instead of copying.
+ * 
+ * The default policy starts with 10 elements and grows by 50% with no page rounding.
+ * 
+ * @see csc_cvector_create_with_growth
+ * @see csc_cvector_set_growth
+ */
+typedef struct csc_cvector_growth {
+    size_t initial; /**< The capacity, in elements, of the first allocation. Must be greater than 0. */
+    size_t factor_percent; /**< The new capacity as a percentage of the old one. Must be at least 100. i.e. 150 grows by 1.5x. */
+    size_t min_step; /**< The minimum number of elements to grow by. */
+    size_t page_size; /**< If not 0, large buffers are rounded up to a multiple of this many bytes. */
+} csc_cvector_growth;
+
+/**
+ * @brief a 2MB huge page size suitable for @c csc_cvector_growth#page_size.
+ * 
+ */
+#define CSC_CVECTOR_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
 /**
  * @brief cvector "constructor" function
  * 
@@ -101,11 +152,309 @@ typedef struct cvector cvector;
  */
 cvector* csc_cvector_create();
 
+/**
+ * @brief cvector "constructor" function that preallocates room for elements.
+ * 
+ * This function is equivalent to #csc_cvector_create followed by #csc_cvector_reserve of @p n elements.
+ * 
+ * @param n the number of elements to allocate room for.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_with_capacity(size_t n);
+
+/**
+ * @brief cvector "constructor" function that preallocates room for elements using a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_create_with_capacity except that the vector and its data are allocated
+ * through @p allocator.
+ * 
+ * @param n the number of elements to allocate room for.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_with_capacity_with_allocator(size_t n, const csc_allocator* allocator);
+
+/**
+ * @brief cvector "constructor" function for inline element storage.
+ * 
+ * This function is used to create a @c cvector that stores its elements contiguously by value instead of
+ * storing @c void* elements. Each element occupies @p elem_size bytes. With this storage mode:
+ * 
+ * - #csc_cvector_add copies @p elem_size bytes from the supplied element into the vector.
+ * - #csc_cvector_at, #csc_cvector_find and #csc_cvector_foreach yield pointers to the element's slot in the vector.
+ * - #csc_cvector_rm and #csc_cvector_rm_at return a pointer to the slot holding the removed element.
+ * 
+ * Pointers to slots are invalidated by any operation that modifies the vector.
+ * 
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p elem_size is 0, @c NULL is returned.
+ * 
+ * @see csc_cvector_destroy
+ * @see csc_cvector_elem_size
+ */
+cvector* csc_cvector_create_sized(size_t elem_size);
+
+/**
+ * @brief cvector "constructor" function using a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_create except that the vector and its data are allocated through
+ * @p allocator. Any temporary buffers the vector's operations need are also allocated through @p allocator.
+ * 
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_with_allocator(const csc_allocator* allocator);
+
+/**
+ * @brief cvector "constructor" function for inline element storage using a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_create_sized except that the vector and its data are allocated through
+ * @p allocator.
+ * 
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p elem_size is 0, @c NULL is returned.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_sized_with_allocator(size_t elem_size, const csc_allocator* allocator);
+
+/**
+ * @brief cvector "constructor" function with a custom growth policy.
+ * 
+ * This function is equivalent to #csc_cvector_create followed by #csc_cvector_set_growth, so the policy already
+ * applies to the first allocation.
+ * 
+ * @param growth the growth policy. Must be @b non-null. See #csc_cvector_growth for more details.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p growth is invalid, @c NULL is returned.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_with_growth(const csc_cvector_growth* growth);
+
+/**
+ * @brief cvector "constructor" function for inline element storage with a custom growth policy.
+ * 
+ * This function is equivalent to #csc_cvector_create_sized followed by #csc_cvector_set_growth.
+ * 
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param growth the growth policy. Must be @b non-null. See #csc_cvector_growth for more details.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p elem_size is 0 or @p growth is invalid, @c NULL
+ * is returned.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_sized_with_growth(size_t elem_size, const csc_cvector_growth* growth);
+
+/**
+ * @brief cvector "constructor" function with a small-buffer optimization.
+ * 
+ * This function is identical to #csc_cvector_create except that room for the first @p n elements is allocated in
+ * the same block as the vector itself. A vector that never holds more than @p n elements therefore costs a single
+ * allocation. Once the vector outgrows the inline buffer, its elements move to the heap and the vector grows as usual.
+ * If the vector later shrinks, #csc_cvector_shrink_to_fit and #csc_cvector_reserve move the elements back into the
+ * inline buffer and release the heap buffer.
+ * 
+ * The capacity of the vector never drops below @p n. If @p n is 0, the vector is identical to one created with
+ * #csc_cvector_create.
+ * 
+ * @param n the number of elements stored inline.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_small(size_t n);
+
+/**
+ * @brief cvector "constructor" function with a small-buffer optimization using a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_create_small except that the vector, including its inline buffer, and
+ * any heap buffer it grows into are allocated through @p allocator.
+ * 
+ * @param n the number of elements stored inline.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_small_with_allocator(size_t n, const csc_allocator* allocator);
+
+/**
+ * @brief cvector "constructor" function for inline element storage with a small-buffer optimization.
+ * 
+ * This function combines #csc_cvector_create_sized and #csc_cvector_create_small: elements are stored by value and
+ * room for the first @p n elements is allocated in the same block as the vector itself.
+ * 
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param n the number of elements stored inline.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p elem_size is 0, @c NULL is returned.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_sized_small(size_t elem_size, size_t n);
+
+/**
+ * @brief cvector "constructor" function for inline element storage with a small-buffer optimization using a custom
+ * allocator.
+ * 
+ * This function is identical to #csc_cvector_create_sized_small except that the vector and its data are allocated
+ * through @p allocator.
+ * 
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param n the number of elements stored inline.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p elem_size is 0, @c NULL is returned.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_sized_small_with_allocator(size_t elem_size, size_t n, const csc_allocator* allocator);
+
+/**
+ * @brief creates a #cvector holding a copy of the supplied array of elements.
+ * 
+ * The vector stores @c void* elements, as if created with #csc_cvector_create, and is populated with a single
+ * allocation and copy rather than @p n calls to #csc_cvector_add.
+ * 
+ * @param array the array of elements to copy. May only be @c NULL if @p n is 0.
+ * @param n the number of elements in @p array.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_add_n
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_from(void* const* array, size_t n);
+
+/**
+ * @brief creates a #cvector holding a copy of the supplied array of elements using a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_create_from except that the vector and its data are allocated through
+ * @p allocator.
+ * 
+ * @param array the array of elements to copy. May only be @c NULL if @p n is 0.
+ * @param n the number of elements in @p array.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_create_from_with_allocator(void* const* array, size_t n, const csc_allocator* allocator);
+
+/**
+ * @brief creates a #cvector that takes ownership of an existing array of elements.
+ * 
+ * No elements are copied. The vector uses @p buffer as its internal data store: the first @p n elements of
+ * @p buffer become the vector's elements and @p cap is its capacity. The buffer is resized with @c realloc and
+ * released with @c free so it @b must have been allocated with @c malloc, @c calloc or @c realloc. After a
+ * successful call, @p buffer must no longer be used directly. The vector uses #csc_default_allocator.
+ * 
+ * @param buffer the heap-allocated array to adopt. May only be @c NULL if @p cap is 0.
+ * @param n the number of elements in @p buffer.
+ * @param cap the number of elements @p buffer has room for.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p n is greater than @p cap, @c NULL is returned
+ * and the caller retains ownership of @p buffer.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_adopt(void** buffer, size_t n, size_t cap);
+
+/**
+ * @brief creates a #cvector that takes ownership of an existing array of elements allocated by a custom allocator.
+ * 
+ * This function is identical to #csc_cvector_adopt except that @p buffer @b must have been allocated through
+ * @p allocator, with a size of @p cap elements, since the vector resizes and releases it through @p allocator. The
+ * vector itself is also allocated through @p allocator.
+ * 
+ * @param buffer the array to adopt. May only be @c NULL if @p cap is 0.
+ * @param n the number of elements in @p buffer.
+ * @param cap the number of elements @p buffer has room for.
+ * @param allocator the allocator. Must be @b non-null. See #csc_allocator for more details.
+ * 
+ * @return a pointer to a constructed #cvector. On failure or if @p n is greater than @p cap, @c NULL is returned
+ * and the caller retains ownership of @p buffer.
+ * 
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_adopt_with_allocator(void** buffer, size_t n, size_t cap, const csc_allocator* allocator);
+
+/**
+ * @brief opens a #cvector whose inline elements live in a memory-mapped file.
+ * 
+ * The vector stores elements by value, as if created with #csc_cvector_create_sized, but its data store is a
+ * shared mapping of the file at @p path. Growing the vector extends the file and remaps it, so elements are never
+ * copied, and reopening the file later makes the elements available immediately without parsing them.
+ * Elements must therefore not contain pointers or anything else that is only meaningful to the current process.
+ * 
+ * The file starts with a header recording a magic number, a layout version, @p elem_size and the number of
+ * elements. If the file doesn't exist or is empty, it is created with an empty vector. Otherwise the header is
+ * checked and files that weren't written by this function, have a different layout version or a different element
+ * size are rejected. The file also records its capacity, so it is as large as the vector's capacity.
+ * 
+ * The element count in the header is written by #csc_cvector_sync and #csc_cvector_destroy. Elements are written
+ * through to the file by the operating system but are only guaranteed to be durable after #csc_cvector_sync.
+ * The file must not be opened by more than one vector at a time.
+ * 
+ * Memory-mapped vectors are only supported on POSIX systems.
+ * 
+ * @param path the path of the file. Must be @b non-null.
+ * @param elem_size the size, in bytes, of a single element. Must be greater than 0.
+ * @param e an optional error code. Can be @c NULL. If non-null, set to @c CSCError#E_NOERR on success,
+ * @c CSCError#E_IO if the file couldn't be opened or resized, @c CSCError#E_INVALIDOPERATION if the file's header
+ * is corrupt or doesn't match @p elem_size, @p elem_size is 0 or the platform doesn't support memory mapping, and
+ * @c CSCError#E_OUTOFMEM if the file couldn't be mapped.
+ * 
+ * @return a pointer to a constructed #cvector or @c NULL on failure.
+ * 
+ * @see csc_cvector_sync
+ * @see csc_cvector_destroy
+ */
+cvector* csc_cvector_open_mapped(const char* path, size_t elem_size, CSCError* e);
+
+/**
+ * @brief flushes a memory-mapped vector to its file.
+ * 
+ * This function writes the element count to the file's header and blocks until the header and the elements have
+ * been written to the file. After it returns, reopening the file with #csc_cvector_open_mapped yields the vector's
+ * current contents.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * 
+ * @return On success @c CSCError#E_NOERR. If @p v isn't memory-mapped @c CSCError#E_INVALIDOPERATION and if the
+ * file couldn't be written @c CSCError#E_IO.
+ * 
+ * @see csc_cvector_open_mapped
+ */
+CSCError csc_cvector_sync(cvector* v);
+
 /**
  * @brief cvector "destructor" function
  * 
  * This function is used to clean up resources used by a @c cvector created via the #csc_cvector_create function.
- * This function must be called whenever a cvector is no longer used.
+ * This function must be called whenever a cvector is no longer used. Memory-mapped vectors record their element
+ * count in their file and close it.
  * 
  * @see csc_cvector_create
  * 
@@ -116,7 +465,8 @@ void csc_cvector_destroy(cvector* v);
  * @brief adds an element into the vector.
  * 
  * This function adds @p elem into the supplied vector. Note that adding the element into the vector does @b not
- * make the vector own the element. The user is still responsible for cleaning up that memory.
+ * make the vector own the element. The user is still responsible for cleaning up that memory. If the vector was
+ * created with #csc_cvector_create_sized, the element is instead copied into the vector.
  * 
  * Both @p elem and @p v are expected to be @b non-null. This means that @c NULL elements are @b not allowed.
  * 
@@ -129,6 +479,49 @@ void csc_cvector_destroy(cvector* v);
  */
 CSCError csc_cvector_add(cvector* v, void* elem);
 
+/**
+ * @brief inserts an element into the vector at the specified 0-indexed position.
+ * 
+ * The elements at and after @p idx are shifted back by one position to make room so the order of the existing
+ * elements is preserved. Inserting at @c csc_cvector_size(v) is equivalent to #csc_cvector_add.
+ * 
+ * Both @p elem and @p v are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param idx the position to insert the element at.
+ * @param elem the element to insert.
+ * 
+ * @return On success, @c CSCError#E_NOERR. If @p idx is greater than the size of the vector,
+ * @c CSCError#E_OUTOFRANGE. On memory allocation failure @c CSCError#E_OUTOFMEM.
+ * 
+ * @see csc_cvector_add
+ */
+CSCError csc_cvector_insert(cvector* v, size_t idx, void* elem);
+
+/**
+ * @brief adds several elements into the vector at once.
+ * 
+ * This function appends the @p n elements of @p elems to the vector, growing the vector at most once. For vectors
+ * storing @c void* elements, @p elems is an array of @c void*. For vectors created with #csc_cvector_create_sized,
+ * @p elems is a packed array of @p n elements that are copied into the vector.
+ * 
+ * @p v is expected to be @b non-null. @p elems may only be @c NULL if @p n is 0.
+ * 
+ * <b>Time Complexity:</b> @c O(n) in the number of elements added.
+ * 
+ * @param v the vector.
+ * @param elems the elements to add.
+ * @param n the number of elements to add.
+ * 
+ * @return On success, @c CSCError#E_NOERR. On memory allocation failure @c CSCError#E_OUTOFMEM, in which case the
+ * vector is left unchanged.
+ * 
+ * @see csc_cvector_add
+ */
+CSCError csc_cvector_add_n(cvector* v, const void* elems, size_t n);
+
 /**
  * @brief removes an element from the vector.
  * 
@@ -143,7 +536,8 @@ CSCError csc_cvector_add(cvector* v, void* elem);
  * @param elem the element to remove.
  * @param cmp the comparison function to use. See #csc_compare for more details.
  * 
- * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL.
+ * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL. For inline storage,
+ * the returned pointer is valid until the vector is next modified.
  * 
  * @see csc_compare
  * @see csc_cvector_find
@@ -163,11 +557,73 @@ void* csc_cvector_rm(cvector* v, const void* elem, csc_compare cmp);
  * @param v the vector.
  * @param idx the index.
  * 
- * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL.
+ * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL. For inline storage,
+ * the returned pointer is valid until the vector is next modified.
  * 
  */ 
 void* csc_cvector_rm_at(cvector* v, size_t idx);
 
+/**
+ * @brief removes the element at the specified 0-indexed index from the vector, preserving the order of the rest.
+ * 
+ * Unlike #csc_cvector_rm_at, which moves the last element into the removed element's position, this function shifts
+ * the elements after @p idx forward by one position.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param idx the index.
+ * 
+ * @return If the element is successfully removed, the element is returned. Otherwise, @c NULL. For inline storage,
+ * the returned pointer is valid until the vector is next modified.
+ * 
+ * @see csc_cvector_rm_at
+ */ 
+void* csc_cvector_rm_at_ordered(cvector* v, size_t idx);
+
+/**
+ * @brief removes the elements in the 0-indexed range [@p first, @p last) from the vector, preserving the order of
+ * the rest.
+ * 
+ * The removed elements are discarded. For vectors storing @c void* elements, any resources they hold must be
+ * released beforehand.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param first the index of the first element to remove.
+ * @param last the index one past the last element to remove.
+ * 
+ * @return On success, @c CSCError#E_NOERR. If @p first is greater than @p last or @p last is greater than the size
+ * of the vector, @c CSCError#E_OUTOFRANGE and the vector is left unchanged.
+ */ 
+CSCError csc_cvector_rm_range(cvector* v, size_t first, size_t last);
+
+/**
+ * @brief removes every element of the vector satisfying a predicate, preserving the order of the rest.
+ * 
+ * The vector is compacted in a single pass so removing many elements costs the same as removing one. @p pred is
+ * called exactly once per element, in order, and the element is not accessed again if @p pred returns @c true. This
+ * makes the predicate a convenient place to release the resources of @c void* elements being removed.
+ * 
+ * All parameters except @p context are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param pred the predicate selecting the elements to remove.
+ * @param context user-defined data that will be applied to the predicate. Can be @c NULL if unused.
+ * 
+ * @return the number of elements removed.
+ * 
+ * @see csc_predicate
+ */ 
+size_t csc_cvector_erase_if(cvector* v, csc_predicate pred, void* context);
+
 /**
  * @brief finds the element in the specified vector.
  * 
@@ -185,6 +641,90 @@ void* csc_cvector_rm_at(cvector* v, size_t idx);
  */ 
 void* csc_cvector_find(const cvector* v, const void* elem, csc_compare cmp);
 
+/**
+ * @brief returns the index of the first element in a sorted vector that is not less than @p elem.
+ * 
+ * The vector must be sorted in ascending order with respect to @p cmp, for instance by #csc_cvector_sort. As with
+ * #csc_cvector_find, @p cmp is called with an element of the vector as its first argument and @p elem as its second.
+ * The search loop is branchless so it doesn't suffer from branch mispredictions on large vectors.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(log(n))
+ * 
+ * @param v the vector.
+ * @param elem the element to search for.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * 
+ * @return the index of the first element not less than @p elem or @c csc_cvector_size(v) if there is none.
+ * 
+ * @see csc_cvector_upper_bound
+ * @see csc_cvector_bsearch
+ */
+size_t csc_cvector_lower_bound(const cvector* v, const void* elem, csc_compare cmp);
+
+/**
+ * @brief returns the index of the first element in a sorted vector that is greater than @p elem.
+ * 
+ * The same requirements as #csc_cvector_lower_bound apply.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(log(n))
+ * 
+ * @param v the vector.
+ * @param elem the element to search for.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * 
+ * @return the index of the first element greater than @p elem or @c csc_cvector_size(v) if there is none.
+ * 
+ * @see csc_cvector_lower_bound
+ */
+size_t csc_cvector_upper_bound(const cvector* v, const void* elem, csc_compare cmp);
+
+/**
+ * @brief finds the element in the specified sorted vector using a binary search.
+ * 
+ * This function is the @c O(log(n)) counterpart of #csc_cvector_find for sorted vectors. The same requirements as
+ * #csc_cvector_lower_bound apply.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(log(n))
+ * 
+ * @param v the vector.
+ * @param elem the element to find.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * 
+ * @return the first element equal to @p elem or @c NULL if the element couldn't be found.
+ * 
+ * @see csc_cvector_lower_bound
+ */
+void* csc_cvector_bsearch(const cvector* v, const void* elem, csc_compare cmp);
+
+/**
+ * @brief finds an @c int key in the specified vector.
+ * 
+ * This function is a specialization of #csc_cvector_find for vectors created with
+ * @c csc_cvector_create_sized(sizeof(int)). Rather than calling a #csc_compare function for each element, the keys
+ * are compared several at a time using SIMD instructions when the CPU supports them. The instruction set is chosen
+ * at runtime and a scalar loop is used otherwise. If @p v stores @c void* elements, this function falls back to
+ * #csc_cvector_find with #csc_cmp_int.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1) best case, O(n) average and worst case.
+ * 
+ * @param v the vector.
+ * @param key the key to find.
+ * 
+ * @return a pointer to the first element equal to @p key or @c NULL if the key couldn't be found or if @p v stores
+ * inline elements whose size isn't @c sizeof(int).
+ * 
+ * @see csc_cvector_find
+ */ 
+int* csc_cvector_find_int(const cvector* v, int key);
+
 /**
  * @brief returns the size of the vector.
  * 
@@ -215,6 +755,37 @@ size_t csc_cvector_size(const cvector* v);
  */
 size_t csc_cvector_capacity(const cvector* v);
 
+/**
+ * @brief sets the policy the vector uses to grow its capacity.
+ * 
+ * The policy is copied into the vector and applies to every subsequent growth, including those triggered by
+ * #csc_cvector_add_n and #csc_cvector_insert. It is usually set right after the vector is created.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param v the vector.
+ * @param growth the growth policy. See #csc_cvector_growth for more details.
+ * 
+ * @return On success, @c CSCError#E_NOERR. If @c csc_cvector_growth#initial is 0 or
+ * @c csc_cvector_growth#factor_percent is less than 100, @c CSCError#E_INVALIDOPERATION.
+ */
+CSCError csc_cvector_set_growth(cvector* v, const csc_cvector_growth* growth);
+
+/**
+ * @brief returns the size, in bytes, of a single inline element of the vector.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param v the vector.
+ *
+ * @return the element size supplied to #csc_cvector_create_sized or 0 if the vector stores @c void* elements.
+ */
+size_t csc_cvector_elem_size(const cvector* v);
+
 /**
  * @brief applies the callback function to each element of the vector.
  * 
@@ -231,6 +802,57 @@ size_t csc_cvector_capacity(const cvector* v);
  */
 void csc_cvector_foreach(cvector* v, csc_foreach fn, void* context);
 
+/**
+ * @brief applies the callback function to each element of the vector using multiple threads.
+ * 
+ * This function is the parallel counterpart of #csc_cvector_foreach. The callback contract is the same but the
+ * callback is invoked concurrently. The vector is split into @c k contiguous chunks of (nearly) equal size, where
+ * @c k is the resolved thread count capped at the vector's size. Chunk @c i covers the indices
+ * <tt>[i * n / k, (i + 1) * n / k)</tt> and is processed in index order by a single thread. Therefore:
+ * 
+ * - each element is passed to @p fn exactly once and may be modified in place without synchronization.
+ * - @p context is shared by all threads so any writes to it must be synchronized by the callback. A common pattern is
+ *   to accumulate per-element results into the elements themselves and combine them afterwards.
+ * 
+ * The vector must not be modified by the callback. The function returns once every element has been processed.
+ * 
+ * All parameters except @p context are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param fn the callback function to apply to each element.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ * @param nthreads the maximum number of threads to use, including the calling thread. If 0, one thread per online
+ * processor is used.
+ * 
+ * @note The worker threads are created and joined by every call. Use #csc_cvector_parallel_foreach_with_pool to
+ * reuse the threads of a #cthreadpool across calls.
+ * 
+ * @see csc_cvector_foreach
+ */
+void csc_cvector_parallel_foreach(cvector* v, csc_foreach fn, void* context, size_t nthreads);
+
+/**
+ * @brief applies the callback function to each element of the vector using the threads of a pool.
+ * 
+ * This function is identical to #csc_cvector_parallel_foreach except that the vector is split into one chunk per
+ * thread of @p p and the work runs on the pool's existing threads.
+ * 
+ * All parameters except @p context are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n)
+ * 
+ * @param v the vector.
+ * @param fn the callback function to apply to each element.
+ * @param context user-defined data that will be applied to the callback. Can be @c NULL if unused.
+ * @param p the pool to run on.
+ * 
+ * @see csc_cvector_parallel_foreach
+ * @see csc_threadpool_create
+ */
+void csc_cvector_parallel_foreach_with_pool(cvector* v, csc_foreach fn, void* context, cthreadpool* p);
+
 /**
  * @brief returns the element at the specified index.
  * 
@@ -304,3 +926,178 @@ CSCError csc_cvector_reserve(cvector* v, size_t num_elems);
  */
 CSCError csc_cvector_shrink_to_fit(cvector* v);
 
+/**
+ * @brief sorts the vector in place.
+ * 
+ * This function sorts the elements of the vector in ascending order as defined by @p cmp. As with
+ * #csc_cvector_find, @p cmp receives the elements themselves for vectors storing @c void* elements and pointers to
+ * the elements' slots for vectors created with #csc_cvector_create_sized.
+ * 
+ * The sort is an introsort: a median-of-three quicksort that switches to heapsort if the recursion gets too deep and
+ * finishes small partitions with insertion sort. The sort is @b not stable and does not allocate memory.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n*log(n)) average and worst case.
+ * 
+ * @param v the vector.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * 
+ * @see csc_cvector_sort_int
+ */
+void csc_cvector_sort(cvector* v, csc_compare cmp);
+
+/**
+ * @brief sorts a vector of @c int keys in place.
+ * 
+ * This function is a specialization of #csc_cvector_sort for vectors created with
+ * @c csc_cvector_create_sized(sizeof(int)). Large vectors are sorted with an LSD radix sort which requires a
+ * temporary buffer the size of the vector. Small vectors and vectors storing @c void* elements are sorted with
+ * #csc_cvector_sort using #csc_cmp_int.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n) for radix sorted vectors. Otherwise, the same as #csc_cvector_sort.
+ * 
+ * @param v the vector.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the temporary buffer couldn't be allocated, @c CSCError#E_OUTOFMEM and
+ * the vector is left unchanged. If @p v stores inline elements whose size isn't @c sizeof(int),
+ * @c CSCError#E_INVALIDOPERATION and the vector is left unchanged.
+ * 
+ * @see csc_cvector_sort
+ */
+CSCError csc_cvector_sort_int(cvector* v);
+
+/**
+ * @brief sorts the vector in place using multiple threads.
+ * 
+ * This function sorts the vector like #csc_cvector_sort but splits the vector into one contiguous chunk per thread,
+ * sorts the chunks concurrently and then merges pairs of sorted chunks in parallel rounds. @p cmp may be called
+ * concurrently from several threads so it must be thread-safe. The merge requires a temporary buffer the size of
+ * the vector. Small vectors are sorted serially.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n*log(n))
+ * 
+ * @param v the vector.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * @param nthreads the maximum number of threads to use, including the calling thread. If 0, one thread per online
+ * processor is used.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the temporary buffer couldn't be allocated, @c CSCError#E_OUTOFMEM and
+ * the vector is left unchanged.
+ * 
+ * @note The worker threads are created once per call and reused by every merge round. Use
+ * #csc_cvector_parallel_sort_with_pool to reuse the threads of a #cthreadpool across calls.
+ * 
+ * @see csc_cvector_sort
+ */
+CSCError csc_cvector_parallel_sort(cvector* v, csc_compare cmp, size_t nthreads);
+
+/**
+ * @brief sorts the vector in place using the threads of a pool.
+ * 
+ * This function is identical to #csc_cvector_parallel_sort except that the vector is split into one chunk per
+ * thread of @p p and the work runs on the pool's existing threads.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(n*log(n))
+ * 
+ * @param v the vector.
+ * @param cmp the comparison function to use. See #csc_compare for more details.
+ * @param p the pool to run on.
+ * 
+ * @return On success @c CSCError#E_NOERR. If the temporary buffer couldn't be allocated, @c CSCError#E_OUTOFMEM and
+ * the vector is left unchanged.
+ * 
+ * @see csc_cvector_parallel_sort
+ * @see csc_threadpool_create
+ */
+CSCError csc_cvector_parallel_sort_with_pool(cvector* v, csc_compare cmp, cthreadpool* p);
+
+/**
+ * @brief an external iterator over the elements of a #cvector.
+ * 
+ * Unlike #csc_cvector_foreach, iterating with a #csc_cvector_iter doesn't require a callback and allows early
+ * termination. Advancing and dereferencing the iterator are inlined so the loop compiles to a plain pointer walk.
+ * The iterator yields the same pointers as #csc_cvector_at and is invalidated by any operation that modifies the vector.
+ * 
+ * @code
+ * for (csc_cvector_iter it = csc_cvector_iter_begin(v); csc_cvector_iter_valid(&it); csc_cvector_iter_next(&it)) {
+ *      int* x = (int*) csc_cvector_iter_get(&it);
+ *      if (*x == 5) {
+ *          break; // early exit
+ *      }
+ * }
+ * @endcode
+ * 
+ * The members are private and should not be accessed directly.
+ * 
+ */
+typedef struct csc_cvector_iter {
+    char* pos; /**< The current slot. */
+    char* end; /**< One past the last slot. */
+    size_t stride; /**< The size of a slot in bytes. */
+    bool by_value; /**< @c true if slots hold elements instead of @c void* pointers. */
+} csc_cvector_iter;
+
+/**
+ * @brief returns an iterator positioned at the first element of the vector.
+ * 
+ * All parameters are expected to be @b non-null.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param v the vector.
+ * 
+ * @return the iterator. If the vector is empty, the iterator is not valid.
+ * 
+ * @see csc_cvector_iter_valid
+ */
+csc_cvector_iter csc_cvector_iter_begin(const cvector* v);
+
+/**
+ * @brief checks if the iterator refers to an element.
+ * 
+ * @param it the iterator.
+ * 
+ * @return @c true if the iterator refers to an element. @c false once the iteration is done.
+ */
+static inline bool csc_cvector_iter_valid(const csc_cvector_iter* it)
+{
+    return it->pos < it->end;
+}
+
+/**
+ * @brief advances the iterator to the next element.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * <b>Time Complexity:</b> @c O(1)
+ * 
+ * @param it the iterator.
+ */
+static inline void csc_cvector_iter_next(csc_cvector_iter* it)
+{
+    it->pos += it->stride;
+}
+
+/**
+ * @brief returns the element the iterator refers to.
+ * 
+ * @p it is expected to be @b non-null and valid.
+ * 
+ * @param it the iterator.
+ * 
+ * @return the element, or a pointer to its slot for vectors created with #csc_cvector_create_sized.
+ */
+static inline void* csc_cvector_iter_get(const csc_cvector_iter* it)
+{
+    if (it->by_value) {
+        return it->pos;
+    }
+    return *(void**)it->pos;
+}
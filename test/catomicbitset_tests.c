@@ -0,0 +1,101 @@
+#include "CuTest.h"
+#include "catomicbitset.h"
+#include "cthreadpool.h"
+
+void TestAtomicBitSetConstruction(CuTest *c)
+{
+    catomicbitset* b = csc_catomicbitset_create(100);
+
+    CuAssertIntEquals(c, 100, csc_catomicbitset_size(b));
+    CuAssertIntEquals(c, 0, csc_catomicbitset_count(b));
+    CuAssertPtrEquals(c, NULL, csc_catomicbitset_create(0));
+
+    csc_catomicbitset_destroy(b);
+}
+
+void TestAtomicBitSetTestAndSet(CuTest *c)
+{
+    catomicbitset* b = csc_catomicbitset_create(100);
+
+    CSCError e;
+    CuAssertTrue(c, !csc_catomicbitset_test_and_set(b, 70, &e));
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertTrue(c, csc_catomicbitset_test_and_set(b, 70, &e));
+    CuAssertTrue(c, csc_catomicbitset_at(b, 70, &e));
+    CuAssertTrue(c, !csc_catomicbitset_at(b, 69, &e));
+
+    CuAssertTrue(c, csc_catomicbitset_test_and_clear(b, 70, &e));
+    CuAssertTrue(c, !csc_catomicbitset_test_and_clear(b, 70, &e));
+    CuAssertTrue(c, !csc_catomicbitset_at(b, 70, &e));
+
+    CuAssertTrue(c, !csc_catomicbitset_test_and_set(b, 100, &e));
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+    CuAssertTrue(c, !csc_catomicbitset_test_and_clear(b, 100, &e));
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+    CuAssertTrue(c, !csc_catomicbitset_at(b, 100, &e));
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+
+    csc_catomicbitset_destroy(b);
+}
+
+void TestAtomicBitSetClaim(CuTest *c)
+{
+    catomicbitset* b = csc_catomicbitset_create(70);
+
+    // claims start at the hint and wrap around.
+    CuAssertIntEquals(c, 65, csc_catomicbitset_claim(b, 65));
+    csc_catomicbitset_test_and_set(b, 66, NULL);
+    CuAssertIntEquals(c, 67, csc_catomicbitset_claim(b, 65));
+    CuAssertIntEquals(c, 0, csc_catomicbitset_claim(b, 1000));
+
+    for (size_t i = 0; i < 66; ++i) {
+        csc_catomicbitset_claim(b, 68);
+    }
+    CuAssertIntEquals(c, 70, csc_catomicbitset_count(b));
+    CuAssertIntEquals(c, 70, csc_catomicbitset_claim(b, 3));
+
+    csc_catomicbitset_test_and_clear(b, 64, NULL);
+    CuAssertIntEquals(c, 64, csc_catomicbitset_claim(b, 65));
+
+    csc_catomicbitset_destroy(b);
+}
+
+#define CSC_CLAIMS_PER_TASK 64
+
+typedef struct claim_context {
+    catomicbitset* b;
+    size_t claimed[8][CSC_CLAIMS_PER_TASK];
+} claim_context;
+
+static void _claim_task(size_t task, void* context)
+{
+    claim_context* ctx = context;
+    for (size_t i = 0; i < CSC_CLAIMS_PER_TASK; ++i) {
+        // every task starts from the same hint so the threads contend for the same words.
+        ctx->claimed[task][i] = csc_catomicbitset_claim(ctx->b, 0);
+    }
+}
+
+void TestAtomicBitSetConcurrentClaim(CuTest *c)
+{
+    static claim_context ctx;
+    ctx.b = csc_catomicbitset_create(8 * CSC_CLAIMS_PER_TASK);
+    cthreadpool* p = csc_threadpool_create(8);
+    csc_threadpool_run(p, 8, _claim_task, &ctx);
+    csc_threadpool_destroy(p);
+
+    // each bit is handed out exactly once.
+    bool seen[8 * CSC_CLAIMS_PER_TASK] = {false};
+    for (size_t t = 0; t < 8; ++t) {
+        for (size_t i = 0; i < CSC_CLAIMS_PER_TASK; ++i) {
+            const size_t bit = ctx.claimed[t][i];
+            CuAssertTrue(c, bit < 8 * CSC_CLAIMS_PER_TASK);
+            CuAssertTrue(c, !seen[bit]);
+            seen[bit] = true;
+        }
+    }
+    CuAssertIntEquals(c, 8 * CSC_CLAIMS_PER_TASK, csc_catomicbitset_count(ctx.b));
+    CuAssertIntEquals(c, 8 * CSC_CLAIMS_PER_TASK, csc_catomicbitset_claim(ctx.b, 0));
+
+    csc_catomicbitset_destroy(ctx.b);
+}
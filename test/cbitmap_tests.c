@@ -0,0 +1,175 @@
+#include "CuTest.h"
+#include "cbitmap.h"
+
+void TestBitmapCreate(CuTest* c)
+{
+    cbitmap* b = csc_cbitmap_create();
+
+    CuAssertTrue(c, csc_cbitmap_empty(b));
+    CuAssertTrue(c, csc_cbitmap_count(b) == 0);
+    CuAssertTrue(c, !csc_cbitmap_at(b, 0));
+    CuAssertTrue(c, !csc_cbitmap_at(b, UINT32_MAX));
+
+    csc_cbitmap_destroy(b);
+}
+
+void TestBitmapSetClear(CuTest* c)
+{
+    cbitmap* b = csc_cbitmap_create();
+
+    const uint32_t bits[] = {0, 7, 65535, 65536, 1000000, UINT32_MAX};
+    for (unsigned i = 0; i < 6; i++) {
+        CuAssertTrue(c, csc_cbitmap_set(b, bits[i]) == E_NOERR);
+    }
+    // setting twice doesn't count twice
+    CuAssertTrue(c, csc_cbitmap_set(b, 7) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_count(b) == 6);
+    for (unsigned i = 0; i < 6; i++) {
+        CuAssertTrue(c, csc_cbitmap_at(b, bits[i]));
+    }
+    CuAssertTrue(c, !csc_cbitmap_at(b, 8));
+    CuAssertTrue(c, !csc_cbitmap_at(b, 65537));
+
+    for (unsigned i = 0; i < 6; i++) {
+        CuAssertTrue(c, csc_cbitmap_clear(b, bits[i]) == E_NOERR);
+        CuAssertTrue(c, !csc_cbitmap_at(b, bits[i]));
+    }
+    CuAssertTrue(c, csc_cbitmap_clear(b, 12345) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_empty(b));
+
+    csc_cbitmap_destroy(b);
+}
+
+void TestBitmapDenseChunk(CuTest* c)
+{
+    cbitmap* b = csc_cbitmap_create();
+
+    // every third value of a chunk overflows an array chunk and becomes a bitmap.
+    for (uint32_t i = 0; i < 65536; i += 3) {
+        CuAssertTrue(c, csc_cbitmap_set(b, (5u << 16) + i) == E_NOERR);
+    }
+    CuAssertTrue(c, csc_cbitmap_count(b) == 21846);
+    for (uint32_t i = 0; i < 65536; i++) {
+        CuAssertTrue(c, csc_cbitmap_at(b, (5u << 16) + i) == (i % 3 == 0));
+    }
+    CuAssertTrue(c, csc_cbitmap_memory(b) < 10000);
+
+    // clearing most of the values turns the chunk back into an array.
+    for (uint32_t i = 0; i < 60000; i += 3) {
+        CuAssertTrue(c, csc_cbitmap_clear(b, (5u << 16) + i) == E_NOERR);
+    }
+    CuAssertTrue(c, csc_cbitmap_count(b) == 1846);
+    CuAssertTrue(c, csc_cbitmap_optimize(b) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_memory(b) < 5000);
+    CuAssertTrue(c, csc_cbitmap_at(b, (5u << 16) + 60000));
+    CuAssertTrue(c, !csc_cbitmap_at(b, (5u << 16) + 59997));
+
+    csc_cbitmap_destroy(b);
+}
+
+void TestBitmapOptimizeRuns(CuTest* c)
+{
+    cbitmap* b = csc_cbitmap_create();
+
+    for (uint32_t i = 100; i < 60000; i++) {
+        csc_cbitmap_set(b, i);
+    }
+    csc_cbitmap_set(b, 62000);
+    const size_t before = csc_cbitmap_memory(b);
+
+    CuAssertTrue(c, csc_cbitmap_optimize(b) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_memory(b) < before / 10);
+    CuAssertTrue(c, csc_cbitmap_count(b) == 59901);
+    CuAssertTrue(c, !csc_cbitmap_at(b, 99));
+    CuAssertTrue(c, csc_cbitmap_at(b, 100));
+    CuAssertTrue(c, csc_cbitmap_at(b, 59999));
+    CuAssertTrue(c, !csc_cbitmap_at(b, 60000));
+    CuAssertTrue(c, csc_cbitmap_at(b, 62000));
+
+    // modifying a run chunk keeps its contents.
+    CuAssertTrue(c, csc_cbitmap_clear(b, 500) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_set(b, 61000) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_count(b) == 59901);
+    CuAssertTrue(c, !csc_cbitmap_at(b, 500));
+    CuAssertTrue(c, csc_cbitmap_at(b, 501));
+    CuAssertTrue(c, csc_cbitmap_at(b, 61000));
+
+    csc_cbitmap_destroy(b);
+}
+
+static cbitmap* _bitmap_with_stride(uint32_t first, uint32_t last, uint32_t stride)
+{
+    cbitmap* b = csc_cbitmap_create();
+    for (uint32_t i = first; i < last; i += stride) {
+        csc_cbitmap_set(b, i);
+    }
+    return b;
+}
+
+void TestBitmapOrAnd(CuTest* c)
+{
+    // mix sparse and dense chunks in different positions.
+    cbitmap* a = _bitmap_with_stride(0, 300000, 2);
+    cbitmap* b = _bitmap_with_stride(100000, 500000, 3);
+    csc_cbitmap_set(b, 4000000000u);
+    csc_cbitmap_optimize(b);
+
+    cbitmap* u = _bitmap_with_stride(0, 0, 1);
+    CuAssertTrue(c, csc_cbitmap_or(u, a) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_or(u, b) == E_NOERR);
+
+    cbitmap* i = _bitmap_with_stride(0, 0, 1);
+    CuAssertTrue(c, csc_cbitmap_or(i, a) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_and(i, b) == E_NOERR);
+
+    uint64_t union_count = 0;
+    uint64_t intersection_count = 0;
+    for (uint32_t x = 0; x < 500000; x++) {
+        const bool in_a = x < 300000 && x % 2 == 0;
+        const bool in_b = x >= 100000 && (x - 100000) % 3 == 0;
+        CuAssertTrue(c, csc_cbitmap_at(u, x) == (in_a || in_b));
+        CuAssertTrue(c, csc_cbitmap_at(i, x) == (in_a && in_b));
+        union_count += (in_a || in_b);
+        intersection_count += (in_a && in_b);
+    }
+    CuAssertTrue(c, csc_cbitmap_at(u, 4000000000u));
+    CuAssertTrue(c, !csc_cbitmap_at(i, 4000000000u));
+    CuAssertTrue(c, csc_cbitmap_count(u) == union_count + 1);
+    CuAssertTrue(c, csc_cbitmap_count(i) == intersection_count);
+
+    cbitmap* empty = csc_cbitmap_create();
+    CuAssertTrue(c, csc_cbitmap_and(u, empty) == E_NOERR);
+    CuAssertTrue(c, csc_cbitmap_empty(u));
+
+    csc_cbitmap_destroy(empty);
+    csc_cbitmap_destroy(i);
+    csc_cbitmap_destroy(u);
+    csc_cbitmap_destroy(b);
+    csc_cbitmap_destroy(a);
+}
+
+static void _collect(size_t bit, void* context)
+{
+    size_t* bits = context;
+    bits[++bits[0]] = bit;
+}
+
+void TestBitmapForEach(CuTest* c)
+{
+    cbitmap* b = csc_cbitmap_create();
+    csc_cbitmap_set(b, 70000);
+    csc_cbitmap_set(b, 3);
+    csc_cbitmap_set(b, 4);
+    csc_cbitmap_set(b, 5);
+    csc_cbitmap_optimize(b);
+
+    size_t bits[5] = {0};
+    csc_cbitmap_foreach(b, _collect, bits);
+    CuAssertIntEquals(c, 4, bits[0]);
+    CuAssertIntEquals(c, 3, bits[1]);
+    CuAssertIntEquals(c, 4, bits[2]);
+    CuAssertIntEquals(c, 5, bits[3]);
+    CuAssertIntEquals(c, 70000, bits[4]);
+
+    csc_cbitmap_destroy(b);
+}
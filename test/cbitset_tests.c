@@ -1,5 +1,9 @@
 #include "CuTest.h"
 #include "cbitset.h"
+#include "test_alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
 
 void TestBitSetConstruction(CuTest *c)
 {
@@ -137,4 +141,426 @@ void TestBitSetClearAll(CuTest *c)
         CuAssertTrue(c, csc_cbitset_at(v, i, NULL) == false);
     }
     csc_cbitset_destroy(v);
-}
\ No newline at end of file
+}
+
+void TestBitSetCreateWithAllocator(CuTest *c)
+{
+    _alloc_stats stats = {0, 0, 0};
+    const csc_allocator a = { _counting_alloc, _counting_realloc, _counting_free, &stats };
+
+    cbitset* v = csc_cbitset_create_with_allocator(100, &a);
+
+    CuAssertIntEquals(c, 100, csc_cbitset_size(v));
+    CuAssertIntEquals(c, 1, stats.allocs);
+    CuAssertTrue(c, csc_cbitset_at(v, 0, NULL) == false);
+
+    csc_cbitset_destroy(v);
+
+    CuAssertIntEquals(c, 1, stats.frees);
+}
+
+void TestBitSetHighBits(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(100);
+
+    CuAssertTrue(c, csc_cbitset_set(v, 99) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_at(v, 99, NULL));
+    CuAssertTrue(c, !csc_cbitset_at(v, 35, NULL));
+    CuAssertTrue(c, csc_cbitset_flip(v, 40) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_at(v, 40, NULL));
+    CuAssertTrue(c, csc_cbitset_clear(v, 99) == E_NOERR);
+    CuAssertTrue(c, !csc_cbitset_at(v, 99, NULL));
+
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetIterator(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(300);
+
+    csc_cbitset_iter it = csc_cbitset_iter_begin(v);
+    CuAssertTrue(c, !csc_cbitset_iter_valid(&it));
+
+    size_t bits[] = {3, 63, 64, 200, 299};
+    for (unsigned i = 0; i < sizeof(bits) / sizeof(size_t); i++) {
+        csc_cbitset_set(v, bits[i]);
+    }
+
+    unsigned n = 0;
+    for (it = csc_cbitset_iter_begin(v); csc_cbitset_iter_valid(&it); csc_cbitset_iter_next(&it)) {
+        CuAssertIntEquals(c, bits[n], csc_cbitset_iter_get(&it));
+        n++;
+    }
+    CuAssertIntEquals(c, 5, n);
+
+    // padding bits past the size are never visited.
+    csc_cbitset_set_all(v);
+    n = 0;
+    for (it = csc_cbitset_iter_begin(v); csc_cbitset_iter_valid(&it); csc_cbitset_iter_next(&it)) {
+        CuAssertIntEquals(c, n, csc_cbitset_iter_get(&it));
+        n++;
+    }
+    CuAssertIntEquals(c, 300, n);
+
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetRangeOps(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(300);
+
+    CuAssertTrue(c, csc_cbitset_set_range(v, 10, 250) == E_NOERR);
+    for (size_t i = 0; i < 300; i++) {
+        CuAssertTrue(c, csc_cbitset_at(v, i, NULL) == (i >= 10 && i < 250));
+    }
+
+    CuAssertTrue(c, csc_cbitset_clear_range(v, 60, 70) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_flip_range(v, 240, 300) == E_NOERR);
+    for (size_t i = 0; i < 300; i++) {
+        const bool expected = (i >= 10 && i < 60) || (i >= 70 && i < 240) || i >= 250;
+        CuAssertTrue(c, csc_cbitset_at(v, i, NULL) == expected);
+    }
+
+    // ranges within a single word
+    csc_cbitset_clear_all(v);
+    CuAssertTrue(c, csc_cbitset_flip_range(v, 3, 5) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_set_range(v, 7, 7) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_get_word(v, 0, NULL) == 0x18);
+
+    CuAssertTrue(c, csc_cbitset_set_range(v, 5, 4) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_cbitset_clear_range(v, 0, 301) == E_OUTOFRANGE);
+
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetWords(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(100);
+    const size_t word_bits = 8 * sizeof(cbitset_word);
+
+    CuAssertIntEquals(c, (100 + word_bits - 1) / word_bits, csc_cbitset_word_count(v));
+
+    CuAssertTrue(c, csc_cbitset_set_word(v, 0, 0x5) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_at(v, 0, NULL));
+    CuAssertTrue(c, !csc_cbitset_at(v, 1, NULL));
+    CuAssertTrue(c, csc_cbitset_at(v, 2, NULL));
+
+    // bits past the size are dropped.
+    const size_t last = csc_cbitset_word_count(v) - 1;
+    CuAssertTrue(c, csc_cbitset_set_word(v, last, ~(cbitset_word)0) == E_NOERR);
+    size_t n = 0;
+    for (csc_cbitset_iter it = csc_cbitset_iter_begin(v); csc_cbitset_iter_valid(&it); csc_cbitset_iter_next(&it)) {
+        n++;
+    }
+    CuAssertIntEquals(c, 2 + (100 - last * word_bits), n);
+
+    CSCError e = E_NOERR;
+    CuAssertTrue(c, csc_cbitset_get_word(v, last + 1, &e) == 0);
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_cbitset_set_word(v, last + 1, 1) == E_OUTOFRANGE);
+
+    // writes through the raw words are visible and invalidate the rank index.
+    CuAssertTrue(c, csc_cbitset_build_index(v) == E_NOERR);
+    cbitset_word* words = csc_cbitset_words(v);
+    CuAssertTrue(c, words[0] == 0x5);
+    words[0] |= 0x2;
+    CuAssertTrue(c, csc_cbitset_at(v, 1, NULL));
+    CuAssertIntEquals(c, 3 + (100 - last * word_bits), csc_cbitset_count(v));
+
+    csc_cbitset_destroy(v);
+}
+
+static void _check_rank_select(CuTest *c, const cbitset* v, size_t nbits)
+{
+    size_t rank = 0;
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertIntEquals(c, rank, csc_cbitset_rank(v, i, NULL));
+        if (csc_cbitset_at(v, i, NULL)) {
+            CuAssertIntEquals(c, i, csc_cbitset_select(v, rank, NULL));
+            rank++;
+        }
+    }
+    CuAssertIntEquals(c, rank, csc_cbitset_rank(v, nbits, NULL));
+    CuAssertIntEquals(c, rank, csc_cbitset_count(v));
+
+    CSCError e = E_NOERR;
+    CuAssertIntEquals(c, nbits, csc_cbitset_select(v, rank, &e));
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+    csc_cbitset_rank(v, nbits + 1, &e);
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+}
+
+void TestBitSetCountRankSelect(CuTest *c)
+{
+    const size_t nbits = 2000;
+    cbitset* v = csc_cbitset_create(nbits);
+
+    CuAssertIntEquals(c, 0, csc_cbitset_count(v));
+    for (size_t i = 0; i < nbits; i += 7) {
+        csc_cbitset_set(v, i);
+    }
+    csc_cbitset_set_range(v, 1000, 1300);
+    _check_rank_select(c, v, nbits);
+
+    CuAssertTrue(c, csc_cbitset_build_index(v) == E_NOERR);
+    _check_rank_select(c, v, nbits);
+
+    // modifications make the index stale and the queries still answer correctly.
+    csc_cbitset_clear_range(v, 0, 500);
+    csc_cbitset_flip(v, 1999);
+    _check_rank_select(c, v, nbits);
+
+    CuAssertTrue(c, csc_cbitset_build_index(v) == E_NOERR);
+    _check_rank_select(c, v, nbits);
+
+    csc_cbitset_destroy(v);
+}
+
+static cbitset* _bitset_with_stride(size_t nbits, size_t stride)
+{
+    cbitset* v = csc_cbitset_create(nbits);
+    for (size_t i = 0; i < nbits; i += stride) {
+        csc_cbitset_set(v, i);
+    }
+    return v;
+}
+
+void TestBitSetSetAlgebra(CuTest *c)
+{
+    // large enough to exercise the vector kernels and their scalar tails.
+    const size_t nbits = 1000;
+    cbitset* twos = _bitset_with_stride(nbits, 2);
+    cbitset* threes = _bitset_with_stride(nbits, 3);
+    cbitset* out = csc_cbitset_create(nbits);
+
+    CuAssertTrue(c, csc_cbitset_and_into(out, twos, threes) == E_NOERR);
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertTrue(c, csc_cbitset_at(out, i, NULL) == (i % 6 == 0));
+    }
+    CuAssertIntEquals(c, csc_cbitset_count(out), csc_cbitset_and_count(twos, threes));
+
+    CuAssertTrue(c, csc_cbitset_or_into(out, twos, threes) == E_NOERR);
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertTrue(c, csc_cbitset_at(out, i, NULL) == (i % 2 == 0 || i % 3 == 0));
+    }
+
+    CuAssertTrue(c, csc_cbitset_xor_into(out, twos, threes) == E_NOERR);
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertTrue(c, csc_cbitset_at(out, i, NULL) == ((i % 2 == 0) != (i % 3 == 0)));
+    }
+
+    CuAssertTrue(c, csc_cbitset_andnot_into(out, twos, threes) == E_NOERR);
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertTrue(c, csc_cbitset_at(out, i, NULL) == (i % 2 == 0 && i % 3 != 0));
+    }
+
+    // in place
+    CuAssertTrue(c, csc_cbitset_or(out, threes) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_xor(out, twos) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_andnot(out, twos) == E_NOERR);
+    CuAssertTrue(c, csc_cbitset_and(out, threes) == E_NOERR);
+    for (size_t i = 0; i < nbits; i++) {
+        CuAssertTrue(c, csc_cbitset_at(out, i, NULL) == (i % 3 == 0 && i % 2 != 0));
+    }
+
+    cbitset* small = csc_cbitset_create(10);
+    CuAssertTrue(c, csc_cbitset_and(out, small) == E_INVALIDOPERATION);
+    CuAssertTrue(c, csc_cbitset_or_into(out, twos, small) == E_INVALIDOPERATION);
+
+    csc_cbitset_destroy(small);
+    csc_cbitset_destroy(out);
+    csc_cbitset_destroy(threes);
+    csc_cbitset_destroy(twos);
+}
+
+void TestBitSetSubsetAndIntersects(CuTest *c)
+{
+    const size_t nbits = 1000;
+    cbitset* twos = _bitset_with_stride(nbits, 2);
+    cbitset* fours = _bitset_with_stride(nbits, 4);
+    cbitset* odd = csc_cbitset_create(nbits);
+    csc_cbitset_set(odd, 999);
+
+    CuAssertTrue(c, csc_cbitset_is_subset(fours, twos));
+    CuAssertTrue(c, !csc_cbitset_is_subset(twos, fours));
+    CuAssertTrue(c, csc_cbitset_intersects(twos, fours));
+    CuAssertTrue(c, !csc_cbitset_intersects(twos, odd));
+
+    // a difference in the last word only
+    csc_cbitset_set(fours, 998);
+    CuAssertTrue(c, csc_cbitset_is_subset(fours, twos));
+    csc_cbitset_set(fours, 997);
+    CuAssertTrue(c, !csc_cbitset_is_subset(fours, twos));
+    CuAssertTrue(c, csc_cbitset_intersects(fours, odd) == false);
+    csc_cbitset_set(fours, 999);
+    CuAssertTrue(c, csc_cbitset_intersects(fours, odd));
+
+    // different sizes compare as if padded with clear bits.
+    cbitset* small = _bitset_with_stride(10, 4);
+    CuAssertTrue(c, csc_cbitset_is_subset(small, twos));
+    CuAssertTrue(c, !csc_cbitset_is_subset(twos, small));
+    CuAssertIntEquals(c, 3, csc_cbitset_and_count(small, twos));
+
+    csc_cbitset_destroy(small);
+    csc_cbitset_destroy(odd);
+    csc_cbitset_destroy(fours);
+    csc_cbitset_destroy(twos);
+}
+
+void TestBitSetFindNext(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(200);
+
+    CuAssertIntEquals(c, 200, csc_cbitset_find_first(v));
+    CuAssertIntEquals(c, 0, csc_cbitset_find_first_zero(v));
+
+    csc_cbitset_set(v, 5);
+    csc_cbitset_set(v, 64);
+    csc_cbitset_set(v, 199);
+    CuAssertIntEquals(c, 5, csc_cbitset_find_first(v));
+    CuAssertIntEquals(c, 5, csc_cbitset_find_next(v, 5));
+    CuAssertIntEquals(c, 64, csc_cbitset_find_next(v, 6));
+    CuAssertIntEquals(c, 199, csc_cbitset_find_next(v, 65));
+    CuAssertIntEquals(c, 200, csc_cbitset_find_next(v, 200));
+
+    csc_cbitset_set_range(v, 0, 150);
+    CuAssertIntEquals(c, 150, csc_cbitset_find_first_zero(v));
+    CuAssertIntEquals(c, 151, csc_cbitset_find_next_zero(v, 151));
+    CuAssertIntEquals(c, 198, csc_cbitset_find_next_zero(v, 198));
+    CuAssertIntEquals(c, 200, csc_cbitset_find_next_zero(v, 199));
+
+    // padding bits past the size are never reported as clear.
+    csc_cbitset_set_all(v);
+    CuAssertIntEquals(c, 200, csc_cbitset_find_first_zero(v));
+
+    csc_cbitset_destroy(v);
+}
+
+static void _collect_bits(size_t bit, void* context)
+{
+    size_t* bits = context;
+    bits[++bits[0]] = bit;
+}
+
+void TestBitSetForEach(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(300);
+    size_t expected[] = {0, 63, 64, 128, 299};
+    for (unsigned i = 0; i < 5; i++) {
+        csc_cbitset_set(v, expected[i]);
+    }
+
+    size_t bits[6] = {0};
+    csc_cbitset_foreach(v, _collect_bits, bits);
+    CuAssertIntEquals(c, 5, bits[0]);
+    for (unsigned i = 0; i < 5; i++) {
+        CuAssertIntEquals(c, expected[i], bits[i + 1]);
+    }
+
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetResize(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(10);
+    csc_cbitset_set(v, 3);
+    csc_cbitset_set(v, 9);
+
+    // grow one bit at a time across several words.
+    for (size_t n = 11; n <= 1000; n++) {
+        CuAssertTrue(c, csc_cbitset_resize(&v, n) == E_NOERR);
+        CuAssertIntEquals(c, n, csc_cbitset_size(v));
+    }
+    CuAssertIntEquals(c, 2, csc_cbitset_count(v));
+    CuAssertTrue(c, csc_cbitset_at(v, 3, NULL));
+    CuAssertTrue(c, csc_cbitset_at(v, 9, NULL));
+    CuAssertTrue(c, csc_cbitset_set(v, 999) == E_NOERR);
+
+    // shrinking drops the bits past the new size and growing again brings back clear bits.
+    csc_cbitset_set_all(v);
+    CuAssertTrue(c, csc_cbitset_resize(&v, 100) == E_NOERR);
+    CuAssertIntEquals(c, 100, csc_cbitset_count(v));
+    CuAssertTrue(c, csc_cbitset_set(v, 100) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_cbitset_resize(&v, 1000) == E_NOERR);
+    CuAssertIntEquals(c, 100, csc_cbitset_count(v));
+    CuAssertIntEquals(c, 100, csc_cbitset_find_first_zero(v));
+
+    CuAssertTrue(c, csc_cbitset_resize(&v, 0) == E_INVALIDOPERATION);
+
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetSerialize(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(1000);
+    csc_cbitset_set(v, 0);
+    csc_cbitset_set(v, 500);
+    csc_cbitset_set(v, 999);
+
+    const size_t len = csc_cbitset_serialized_size(v);
+    char* buf = malloc(len + 1);
+    CuAssertTrue(c, csc_cbitset_serialize(v, buf, len - 1) == E_OUTOFRANGE);
+
+    // a copying load doesn't depend on the alignment of the buffer.
+    CuAssertTrue(c, csc_cbitset_serialize(v, buf + 1, len) == E_NOERR);
+    CSCError e;
+    cbitset* copy = csc_cbitset_deserialize(buf + 1, len, &e);
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertIntEquals(c, 1000, csc_cbitset_size(copy));
+    CuAssertIntEquals(c, 3, csc_cbitset_count(copy));
+    CuAssertTrue(c, csc_cbitset_at(copy, 500, NULL));
+    csc_cbitset_destroy(copy);
+
+    // but a view requires aligned words.
+    CuAssertPtrEquals(c, NULL, csc_cbitset_view(buf + 1, len, &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    CuAssertPtrEquals(c, NULL, csc_cbitset_deserialize(buf + 1, len - 1, &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+    buf[1] = 'X';
+    CuAssertPtrEquals(c, NULL, csc_cbitset_deserialize(buf + 1, len, &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    free(buf);
+    csc_cbitset_destroy(v);
+}
+
+void TestBitSetView(CuTest *c)
+{
+    cbitset* v = csc_cbitset_create(130);
+    csc_cbitset_set(v, 129);
+
+    // write the bitset to a file and use the mapped file in place.
+    FILE* f = tmpfile();
+    CuAssertTrue(c, csc_cbitset_write(v, fileno(f)) == E_NOERR);
+    const size_t len = csc_cbitset_serialized_size(v);
+    void* buf = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(f), 0);
+    CuAssertTrue(c, buf != MAP_FAILED);
+
+    CSCError e;
+    cbitset* view = csc_cbitset_view(buf, len, &e);
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertIntEquals(c, 130, csc_cbitset_size(view));
+    CuAssertTrue(c, csc_cbitset_at(view, 129, NULL));
+    CuAssertIntEquals(c, 1, csc_cbitset_count(view));
+
+    // changes go straight to the mapping.
+    csc_cbitset_set(view, 7);
+    cbitset* copy = csc_cbitset_deserialize(buf, len, &e);
+    CuAssertTrue(c, csc_cbitset_at(copy, 7, NULL));
+    csc_cbitset_destroy(copy);
+
+    CuAssertTrue(c, csc_cbitset_resize(&view, 200) == E_INVALIDOPERATION);
+    csc_cbitset_destroy(view);
+
+    // bits set past the end of the bitset are rejected rather than fixed up in place.
+    csc_cbitset_words(v)[csc_cbitset_word_count(v) - 1] = 0;
+    csc_cbitset_serialize(v, buf, len);
+    ((cbitset_word*)((char*)buf + len))[-1] = ~(cbitset_word)0;
+    CuAssertPtrEquals(c, NULL, csc_cbitset_view(buf, len, &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    munmap(buf, len);
+    fclose(f);
+    csc_cbitset_destroy(v);
+}
@@ -0,0 +1,222 @@
+#include "CuTest.h"
+#include "cbloom.h"
+#include "cbitset.h"
+#include <stdlib.h>
+#include <string.h>
+
+void TestBloomCreate(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create(1000, 0.01);
+
+    // about 9.6 bits and 7 hash functions per key for a 1% false positive rate.
+    CuAssertTrue(c, csc_cbloom_bits(f) >= 9500 && csc_cbloom_bits(f) <= 9700);
+    CuAssertIntEquals(c, 7, csc_cbloom_hashes(f));
+    CuAssertTrue(c, !csc_cbloom_maybe_contains(f, "key", 3));
+
+    CuAssertPtrEquals(c, NULL, csc_cbloom_create(0, 0.01));
+    CuAssertPtrEquals(c, NULL, csc_cbloom_create(1000, 0.0));
+    CuAssertPtrEquals(c, NULL, csc_cbloom_create(1000, 1.0));
+
+    csc_cbloom_destroy(f);
+}
+
+// adds n keys and returns the number of false positives among n keys that weren't added.
+static size_t _false_positives(CuTest* c, cbloom* f, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        csc_cbloom_add(f, &i, sizeof(i));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        CuAssertTrue(c, csc_cbloom_maybe_contains(f, &i, sizeof(i)));
+    }
+
+    size_t false_positives = 0;
+    for (size_t i = n; i < 2 * n; ++i) {
+        false_positives += csc_cbloom_maybe_contains(f, &i, sizeof(i));
+    }
+    return false_positives;
+}
+
+void TestBloomFalsePositiveRate(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create(20000, 0.01);
+    CuAssertTrue(c, _false_positives(c, f, 20000) < 300);
+
+    csc_cbloom_clear(f);
+    CuAssertTrue(c, !csc_cbloom_maybe_contains(f, "0", 1));
+
+    csc_cbloom_destroy(f);
+}
+
+void TestBloomBlocked(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create_blocked(20000, 0.01);
+
+    CuAssertTrue(c, csc_cbloom_bits(f) % 512 == 0);
+    CuAssertTrue(c, _false_positives(c, f, 20000) < 400);
+
+    csc_cbloom_destroy(f);
+}
+
+void TestBloomHash(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create_blocked(100, 0.01);
+
+    csc_cbloom_add_hash(f, 0x123456789abcdefULL);
+    CuAssertTrue(c, csc_cbloom_maybe_contains_hash(f, 0x123456789abcdefULL));
+
+    // keys of every length up to the word size hash differently.
+    const char* key = "abcdefghijklmnop";
+    for (size_t len = 0; len <= 16; ++len) {
+        csc_cbloom_add(f, key, len);
+    }
+    for (size_t len = 0; len <= 16; ++len) {
+        CuAssertTrue(c, csc_cbloom_maybe_contains(f, key, len));
+    }
+
+    csc_cbloom_destroy(f);
+}
+
+void TestBloomUnion(CuTest *c)
+{
+    for (int blocked = 0; blocked <= 1; ++blocked) {
+        cbloom* a = csc_cbloom_create_with_allocator(1000, 0.01, blocked, csc_default_allocator());
+        cbloom* b = csc_cbloom_create_with_allocator(1000, 0.01, blocked, csc_default_allocator());
+        csc_cbloom_add(a, "left", 4);
+        csc_cbloom_add(b, "right", 5);
+
+        CuAssertTrue(c, csc_cbloom_union(a, b) == E_NOERR);
+        CuAssertTrue(c, csc_cbloom_maybe_contains(a, "left", 4));
+        CuAssertTrue(c, csc_cbloom_maybe_contains(a, "right", 5));
+
+        csc_cbloom_destroy(b);
+        csc_cbloom_destroy(a);
+    }
+
+    cbloom* a = csc_cbloom_create(1000, 0.01);
+    cbloom* b = csc_cbloom_create(1000, 0.001);
+    cbloom* blocked = csc_cbloom_create_blocked(1000, 0.01);
+    CuAssertTrue(c, csc_cbloom_union(a, b) == E_INVALIDOPERATION);
+    CuAssertTrue(c, csc_cbloom_union(a, blocked) == E_INVALIDOPERATION);
+
+    csc_cbloom_destroy(blocked);
+    csc_cbloom_destroy(b);
+    csc_cbloom_destroy(a);
+}
+
+void TestBloomSerialize(CuTest *c)
+{
+    for (int blocked = 0; blocked <= 1; ++blocked) {
+        cbloom* f = csc_cbloom_create_with_allocator(1000, 0.01, blocked, csc_default_allocator());
+        for (size_t i = 0; i < 1000; ++i) {
+            csc_cbloom_add(f, &i, sizeof(i));
+        }
+
+        const size_t len = csc_cbloom_serialized_size(f);
+        char* buf = malloc(len + 1);
+        CuAssertTrue(c, csc_cbloom_serialize(f, buf, len - 1) == E_OUTOFRANGE);
+
+        // the copy must not depend on the alignment of the buffer.
+        CuAssertTrue(c, csc_cbloom_serialize(f, buf + 1, len) == E_NOERR);
+        CSCError e;
+        cbloom* copy = csc_cbloom_deserialize(buf + 1, len, &e);
+        CuAssertTrue(c, e == E_NOERR);
+        CuAssertIntEquals(c, csc_cbloom_bits(f), csc_cbloom_bits(copy));
+        CuAssertIntEquals(c, csc_cbloom_hashes(f), csc_cbloom_hashes(copy));
+        for (size_t i = 0; i < 2000; ++i) {
+            CuAssertTrue(c, csc_cbloom_maybe_contains(f, &i, sizeof(i)) ==
+                            csc_cbloom_maybe_contains(copy, &i, sizeof(i)));
+        }
+
+        CuAssertPtrEquals(c, NULL, csc_cbloom_deserialize(buf + 1, len - 1, &e));
+        CuAssertTrue(c, e == E_INVALIDOPERATION);
+        buf[1] = 'X';
+        CuAssertPtrEquals(c, NULL, csc_cbloom_deserialize(buf + 1, len, &e));
+        CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+        free(buf);
+        csc_cbloom_destroy(copy);
+        csc_cbloom_destroy(f);
+    }
+}
+
+void TestBloomDeserializeRejectsHashCount(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create(1000, 0.01);
+    const size_t len = csc_cbloom_serialized_size(f);
+    char* buf = malloc(len);
+    CuAssertTrue(c, csc_cbloom_serialize(f, buf, len) == E_NOERR);
+
+    // the hash count is the 32 bit field at offset 24 of the header.
+    const uint32_t counts[] = {0, 65, UINT32_MAX};
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        memcpy(buf + 24, &counts[i], sizeof(counts[i]));
+        CSCError e = E_NOERR;
+        CuAssertPtrEquals(c, NULL, csc_cbloom_deserialize(buf, len, &e));
+        CuAssertTrue(c, e == E_INVALIDOPERATION);
+    }
+
+    const uint32_t k = 64;
+    memcpy(buf + 24, &k, sizeof(k));
+    cbloom* copy = csc_cbloom_deserialize(buf, len, NULL);
+    CuAssertIntEquals(c, 64, csc_cbloom_hashes(copy));
+
+    csc_cbloom_destroy(copy);
+    free(buf);
+    csc_cbloom_destroy(f);
+}
+
+// must match the finalizer cbloom uses to derive the probe step from the hash.
+static uint64_t _mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// returns the number of bits set in the filter.
+static size_t _bits_set(cbloom* f)
+{
+    const size_t len = csc_cbloom_serialized_size(f);
+    const size_t word_bits = sizeof(cbitset_word) * 8;
+    const size_t nbytes = ((csc_cbloom_bits(f) + word_bits - 1) / word_bits) * sizeof(cbitset_word);
+    unsigned char* buf = malloc(len);
+    csc_cbloom_serialize(f, buf, len);
+
+    size_t n = 0;
+    for (size_t i = len - nbytes; i < len; ++i) {
+        for (unsigned char b = buf[i]; b != 0; b &= (unsigned char)(b - 1)) {
+            ++n;
+        }
+    }
+    free(buf);
+    return n;
+}
+
+void TestBloomDistinctProbes(CuTest *c)
+{
+    cbloom* f = csc_cbloom_create(1, 0.01);
+    const size_t nbits = csc_cbloom_bits(f);
+    const size_t k = csc_cbloom_hashes(f);
+    CuAssertTrue(c, k > 1 && k <= nbits);
+
+    // a hash whose second hash is a multiple of the number of bits.
+    uint64_t hash = 0;
+    while (_mix(hash ^ 0x9e3779b97f4a7c15ULL) % nbits != 0) {
+        ++hash;
+    }
+    csc_cbloom_add_hash(f, hash);
+    CuAssertIntEquals(c, k, _bits_set(f));
+    CuAssertTrue(c, csc_cbloom_maybe_contains_hash(f, hash));
+
+    for (hash = 0; hash < 1000; ++hash) {
+        csc_cbloom_clear(f);
+        csc_cbloom_add_hash(f, hash);
+        CuAssertIntEquals(c, k, _bits_set(f));
+    }
+
+    csc_cbloom_destroy(f);
+}
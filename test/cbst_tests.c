@@ -1,5 +1,6 @@
 #include "CuTest.h"
 #include "cbst.h"
+#include "test_alloc.h"
 
 void TestBSTCreate(CuTest *c)
 {
@@ -259,4 +260,156 @@ void TestBSTRemoveNull(CuTest* c)
     CuAssertPtrEquals(c, NULL, ret);
 
     TestBSTForEach(c);
-}
\ No newline at end of file
+}
+
+void TestBSTCreateWithAllocator(CuTest* c)
+{
+    _alloc_stats stats = {0, 0, 0};
+    const csc_allocator a = { _counting_alloc, _counting_realloc, _counting_free, &stats };
+
+    cbst* b = csc_cbst_create_with_allocator(&a);
+
+    int input[] = {2, 1, 3};
+    for (unsigned i = 0; i < sizeof(input) / sizeof(int); i++) {
+        csc_cbst_add(b, &input[i], csc_cmp_int);
+    }
+    CuAssertIntEquals(c, 4, stats.allocs);
+
+    csc_cbst_destroy(b);
+
+    CuAssertIntEquals(c, 4, stats.frees);
+}
+
+void TestBSTRemoveRootWithDeepSuccessor(CuTest* c)
+{
+    cbst* b = csc_cbst_create();
+
+    int input[] = {5, 2, 9, 7, 10, 6, 8};
+    for (unsigned i = 0; i < sizeof(input) / sizeof(int); i++) {
+        csc_cbst_add(b, &input[i], csc_cmp_int);
+    }
+
+    // 5 is replaced by its successor 6 which isn't a direct child of 5.
+    void* ret = csc_cbst_rm(b, &input[0], csc_cmp_int);
+    CuAssertPtrEquals(c, &input[0], ret);
+    CuAssertIntEquals(c, 6, csc_cbst_size(b));
+    CuAssertPtrEquals(c, NULL, csc_cbst_find(b, &input[0], csc_cmp_int));
+
+    int output[6];
+    _test t = {.elems = output, .idx = 0 };
+    csc_cbst_foreach(b, _cbst_foreach, &t);
+
+    int expected[] = {2, 6, 7, 8, 9, 10};
+    CuAssertIntEquals(c, 6, t.idx);
+    for (unsigned i = 0; i < 6; i++) {
+        CuAssertIntEquals(c, expected[i], output[i]);
+    }
+
+    csc_cbst_destroy(b);
+}
+
+void TestBSTIterator(CuTest* c)
+{
+    cbst* b = csc_cbst_create();
+
+    csc_cbst_iter it = csc_cbst_iter_begin(b);
+    CuAssertTrue(c, !csc_cbst_iter_valid(&it));
+
+    int input[] = {4, 2, 6, 1, 3, 5, 7};
+    for (unsigned i = 0; i < sizeof(input) / sizeof(int); i++) {
+        csc_cbst_add(b, &input[i], csc_cmp_int);
+    }
+
+    int expected = 1;
+    for (it = csc_cbst_iter_begin(b); csc_cbst_iter_valid(&it); csc_cbst_iter_next(&it)) {
+        CuAssertIntEquals(c, expected, *(int*)csc_cbst_iter_get(&it));
+        expected++;
+    }
+    CuAssertIntEquals(c, 8, expected);
+
+    // stop early
+    for (it = csc_cbst_iter_begin(b); csc_cbst_iter_valid(&it); csc_cbst_iter_next(&it)) {
+        if (*(int*)csc_cbst_iter_get(&it) == 3) {
+            break;
+        }
+    }
+    CuAssertTrue(c, csc_cbst_iter_valid(&it));
+    CuAssertIntEquals(c, 3, *(int*)csc_cbst_iter_get(&it));
+
+    csc_cbst_destroy(b);
+}
+
+// returns the largest height a red-black tree of n elements can have.
+static size_t _max_height(size_t n)
+{
+    size_t log2 = 0;
+    while (((size_t)1 << log2) < n + 1) {
+        log2++;
+    }
+    return 2 * log2;
+}
+
+void TestBSTBalancedSortedAdd(CuTest* c)
+{
+    static int keys[100000];
+    cbst* b = csc_cbst_create();
+
+    for (int i = 0; i < 100000; i++) {
+        keys[i] = i;
+        CuAssertTrue(c, csc_cbst_add(b, &keys[i], csc_cmp_int) == E_NOERR);
+    }
+    CuAssertIntEquals(c, 100000, csc_cbst_size(b));
+    CuAssertTrue(c, csc_cbst_height(b) <= _max_height(100000));
+    CuAssertPtrEquals(c, &keys[99999], csc_cbst_find(b, &keys[99999], csc_cmp_int));
+
+    // descending input is balanced too.
+    cbst* r = csc_cbst_create();
+    for (int i = 99999; i >= 0; i--) {
+        csc_cbst_add(r, &keys[i], csc_cmp_int);
+    }
+    CuAssertTrue(c, csc_cbst_height(r) <= _max_height(100000));
+
+    csc_cbst_destroy(r);
+    csc_cbst_destroy(b);
+}
+
+void TestBSTBalancedRemove(CuTest* c)
+{
+    static int keys[4096];
+    static bool removed[4096];
+    cbst* b = csc_cbst_create();
+    CuAssertIntEquals(c, 0, csc_cbst_height(b));
+
+    for (int i = 0; i < 4096; i++) {
+        keys[i] = i;
+        removed[i] = false;
+        csc_cbst_add(b, &keys[i], csc_cmp_int);
+    }
+
+    // remove the keys in a scrambled order, checking the tree as it shrinks.
+    for (size_t k = 0; k < 4096; k++) {
+        const size_t i = (k * 1237) % 4096;
+        CuAssertPtrEquals(c, &keys[i], csc_cbst_rm(b, &keys[i], csc_cmp_int));
+        removed[i] = true;
+
+        if (k % 256 == 0) {
+            const size_t size = csc_cbst_size(b);
+            CuAssertIntEquals(c, 4096 - k - 1, size);
+            CuAssertTrue(c, csc_cbst_height(b) <= _max_height(size));
+
+            int prev = -1;
+            size_t n = 0;
+            for (csc_cbst_iter it = csc_cbst_iter_begin(b); csc_cbst_iter_valid(&it); csc_cbst_iter_next(&it)) {
+                const int x = *(int*)csc_cbst_iter_get(&it);
+                CuAssertTrue(c, x > prev && !removed[x]);
+                prev = x;
+                n++;
+            }
+            CuAssertIntEquals(c, size, n);
+        }
+    }
+    CuAssertTrue(c, csc_cbst_empty(b));
+    CuAssertIntEquals(c, 0, csc_cbst_height(b));
+
+    csc_cbst_destroy(b);
+}
@@ -0,0 +1,87 @@
+#include "CuTest.h"
+#include "cflatset.h"
+
+void TestFlatSetCreate(CuTest* c)
+{
+    cflatset* s = csc_cflatset_create(csc_cmp_int);
+
+    CuAssertIntEquals(c, 0, csc_cflatset_size(s));
+    CuAssertTrue(c, csc_cflatset_empty(s));
+
+    csc_cflatset_destroy(s);
+}
+
+void TestFlatSetCreateSizedZeroSize(CuTest* c)
+{
+    CuAssertPtrEquals(c, NULL, csc_cflatset_create_sized(0, csc_cmp_int));
+}
+
+void TestFlatSetAddKeepsOrder(CuTest* c)
+{
+    cflatset* s = csc_cflatset_create(csc_cmp_int);
+
+    int input[] = {5, 1, 4, 2, 3};
+    for (int i = 0; i < 5; i++) {
+        CuAssertTrue(c, csc_cflatset_add(s, &input[i]) == E_NOERR);
+    }
+
+    CuAssertIntEquals(c, 5, csc_cflatset_size(s));
+    for (int i = 0; i < 5; i++) {
+        CuAssertIntEquals(c, i + 1, *(int*) csc_cflatset_at(s, i));
+    }
+
+    csc_cflatset_destroy(s);
+}
+
+void TestFlatSetAddDuplicate(CuTest* c)
+{
+    cflatset* s = csc_cflatset_create_sized(sizeof(int), csc_cmp_int);
+
+    int x = 1;
+    CuAssertTrue(c, csc_cflatset_add(s, &x) == E_NOERR);
+    CuAssertTrue(c, csc_cflatset_add(s, &x) == E_INVALIDOPERATION);
+    CuAssertTrue(c, csc_cflatset_add(s, NULL) == E_INVALIDOPERATION);
+    CuAssertIntEquals(c, 1, csc_cflatset_size(s));
+
+    csc_cflatset_destroy(s);
+}
+
+void TestFlatSetFind(CuTest* c)
+{
+    cflatset* s = csc_cflatset_create_sized(sizeof(int), csc_cmp_int);
+
+    for (int i = 100; i > 0; i -= 2) {
+        csc_cflatset_add(s, &i);
+    }
+
+    for (int i = 1; i <= 100; i++) {
+        int* found = (int*) csc_cflatset_find(s, &i);
+        if (i % 2 == 0) {
+            CuAssertPtrNotNull(c, found);
+            CuAssertIntEquals(c, i, *found);
+        } else {
+            CuAssertPtrEquals(c, NULL, found);
+        }
+    }
+
+    csc_cflatset_destroy(s);
+}
+
+void TestFlatSetRm(CuTest* c)
+{
+    cflatset* s = csc_cflatset_create(csc_cmp_int);
+
+    int x[] = {1, 2, 3};
+    for (int i = 0; i < 3; i++) {
+        csc_cflatset_add(s, &x[i]);
+    }
+
+    CuAssertPtrEquals(c, &x[1], csc_cflatset_rm(s, &x[1]));
+    CuAssertPtrEquals(c, NULL, csc_cflatset_rm(s, &x[1]));
+
+    CuAssertIntEquals(c, 2, csc_cflatset_size(s));
+    CuAssertPtrEquals(c, &x[0], csc_cflatset_at(s, 0));
+    CuAssertPtrEquals(c, &x[2], csc_cflatset_at(s, 1));
+
+    csc_cflatset_destroy(s);
+}
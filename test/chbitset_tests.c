@@ -0,0 +1,96 @@
+#include "CuTest.h"
+#include "chbitset.h"
+
+void TestHBitSetConstruction(CuTest *c)
+{
+    chbitset* b = csc_chbitset_create(65);
+
+    CuAssertIntEquals(c, 65, csc_chbitset_size(b));
+    CuAssertTrue(c, csc_chbitset_empty(b));
+    CuAssertIntEquals(c, 65, csc_chbitset_find_first(b));
+    CuAssertPtrEquals(c, NULL, csc_chbitset_create(0));
+
+    csc_chbitset_destroy(b);
+}
+
+void TestHBitSetSetClear(CuTest *c)
+{
+    chbitset* b = csc_chbitset_create(300000);
+
+    CSCError e;
+    CuAssertTrue(c, csc_chbitset_set(b, 299999) == E_NOERR);
+    CuAssertTrue(c, csc_chbitset_set(b, 299998) == E_NOERR);
+    CuAssertTrue(c, csc_chbitset_at(b, 299999, &e));
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertTrue(c, !csc_chbitset_at(b, 0, &e));
+    CuAssertTrue(c, !csc_chbitset_empty(b));
+
+    CuAssertTrue(c, csc_chbitset_set(b, 300000) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_chbitset_clear(b, 300000) == E_OUTOFRANGE);
+    CuAssertTrue(c, !csc_chbitset_at(b, 300000, &e));
+    CuAssertTrue(c, e == E_OUTOFRANGE);
+
+    // the summaries stay set until the last bit of the word is cleared.
+    CuAssertTrue(c, csc_chbitset_clear(b, 299999) == E_NOERR);
+    CuAssertTrue(c, !csc_chbitset_empty(b));
+    CuAssertIntEquals(c, 299998, csc_chbitset_find_first(b));
+    CuAssertTrue(c, csc_chbitset_clear(b, 299998) == E_NOERR);
+    CuAssertTrue(c, csc_chbitset_empty(b));
+    CuAssertIntEquals(c, 300000, csc_chbitset_find_first(b));
+
+    csc_chbitset_destroy(b);
+}
+
+void TestHBitSetFindNext(CuTest *c)
+{
+    // large enough for four levels.
+    const size_t nbits = 20000000;
+    chbitset* b = csc_chbitset_create(nbits);
+
+    const size_t bits[] = {3, 64, 4095, 4096, 262143, 262144, 10000000, 19999999};
+    for (size_t i = 0; i < 8; ++i) {
+        csc_chbitset_set(b, bits[i]);
+    }
+
+    CuAssertIntEquals(c, 3, csc_chbitset_find_first(b));
+    size_t bit = csc_chbitset_find_first(b);
+    for (size_t i = 0; i < 8; ++i) {
+        CuAssertIntEquals(c, bits[i], bit);
+        bit = csc_chbitset_find_next(b, bit + 1);
+    }
+    CuAssertIntEquals(c, nbits, bit);
+
+    CuAssertIntEquals(c, 10000000, csc_chbitset_find_next(b, 262145));
+    CuAssertIntEquals(c, 19999999, csc_chbitset_find_next(b, 10000001));
+    CuAssertIntEquals(c, nbits, csc_chbitset_find_next(b, nbits));
+
+    csc_chbitset_clear(b, 10000000);
+    CuAssertIntEquals(c, 19999999, csc_chbitset_find_next(b, 262145));
+
+    csc_chbitset_destroy(b);
+}
+
+static void _collect(size_t bit, void* context)
+{
+    size_t* bits = context;
+    bits[++bits[0]] = bit;
+}
+
+void TestHBitSetForEach(CuTest *c)
+{
+    chbitset* b = csc_chbitset_create(1000000);
+    csc_chbitset_set(b, 999999);
+    csc_chbitset_set(b, 5);
+    csc_chbitset_set(b, 6);
+    csc_chbitset_set(b, 70000);
+
+    size_t bits[5] = {0};
+    csc_chbitset_foreach(b, _collect, bits);
+    CuAssertIntEquals(c, 4, bits[0]);
+    CuAssertIntEquals(c, 5, bits[1]);
+    CuAssertIntEquals(c, 6, bits[2]);
+    CuAssertIntEquals(c, 70000, bits[3]);
+    CuAssertIntEquals(c, 999999, bits[4]);
+
+    csc_chbitset_destroy(b);
+}
@@ -0,0 +1,80 @@
+#include "CuTest.h"
+#include "csoa.h"
+
+static const size_t _columns[] = {sizeof(int), sizeof(double), sizeof(char)};
+
+void TestSoaCreate(CuTest* c)
+{
+    csoa* t = csc_csoa_create(_columns, 3);
+
+    CuAssertIntEquals(c, 0, csc_csoa_size(t));
+    CuAssertIntEquals(c, 3, csc_csoa_columns(t));
+    CuAssertTrue(c, csc_csoa_empty(t));
+    CuAssertPtrEquals(c, NULL, csc_csoa_column(t, 0));
+
+    csc_csoa_destroy(t);
+}
+
+void TestSoaCreateInvalid(CuTest* c)
+{
+    CuAssertPtrEquals(c, NULL, csc_csoa_create(_columns, 0));
+
+    const size_t columns[] = {sizeof(int), 0};
+    CuAssertPtrEquals(c, NULL, csc_csoa_create(columns, 2));
+}
+
+static void _sum_doubles(void* elem, void* context)
+{
+    *(double*)context += *(double*)elem;
+}
+
+void TestSoaAddAndScan(CuTest* c)
+{
+    csoa* t = csc_csoa_create(_columns, 3);
+
+    for (int i = 0; i < 100; i++) {
+        double d = i * 2.0;
+        char ch = (char)('a' + (i % 26));
+        void* row[] = {&i, &d, &ch};
+        CuAssertTrue(c, csc_csoa_add(t, row) == E_NOERR);
+    }
+    CuAssertIntEquals(c, 100, csc_csoa_size(t));
+
+    const int* ids = csc_csoa_column(t, 0);
+    const double* values = csc_csoa_column(t, 1);
+    for (int i = 0; i < 100; i++) {
+        CuAssertIntEquals(c, i, ids[i]);
+        CuAssertDblEquals(c, i * 2.0, values[i], 0.0);
+    }
+    CuAssertTrue(c, *(char*)csc_csoa_at(t, 2, 27) == 'b');
+    CuAssertPtrEquals(c, NULL, csc_csoa_at(t, 3, 0));
+    CuAssertPtrEquals(c, NULL, csc_csoa_at(t, 0, 100));
+
+    double sum = 0;
+    csc_csoa_foreach(t, 1, _sum_doubles, &sum);
+    CuAssertDblEquals(c, 9900.0, sum, 0.0);
+
+    csc_csoa_destroy(t);
+}
+
+void TestSoaRemoveAt(CuTest* c)
+{
+    csoa* t = csc_csoa_create(_columns, 2);
+
+    for (int i = 0; i < 3; i++) {
+        double d = i;
+        void* row[] = {&i, &d};
+        csc_csoa_add(t, row);
+    }
+
+    CuAssertTrue(c, csc_csoa_rm_at(t, 3) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_csoa_rm_at(t, 0) == E_NOERR);
+    CuAssertIntEquals(c, 2, csc_csoa_size(t));
+
+    // the last row moved into the removed row in every column.
+    CuAssertIntEquals(c, 2, *(int*)csc_csoa_at(t, 0, 0));
+    CuAssertDblEquals(c, 2.0, *(double*)csc_csoa_at(t, 1, 0), 0.0);
+    CuAssertIntEquals(c, 1, *(int*)csc_csoa_at(t, 0, 1));
+
+    csc_csoa_destroy(t);
+}
@@ -0,0 +1,46 @@
+#include "CuTest.h"
+#include "cthreadpool.h"
+
+#define CSC_POOL_TASKS 1000
+
+static void _record_task(size_t task, void* context)
+{
+    size_t* runs = context;
+    ++runs[task];
+}
+
+void TestThreadPoolCreate(CuTest *c)
+{
+    cthreadpool* p = csc_threadpool_create(4);
+
+    CuAssertTrue(c, p != NULL);
+    CuAssertTrue(c, csc_threadpool_threads(p) >= 1 && csc_threadpool_threads(p) <= 4);
+
+    csc_threadpool_destroy(p);
+
+    p = csc_threadpool_create(0);
+    CuAssertTrue(c, csc_threadpool_threads(p) <= csc_threadpool_default_threads());
+    csc_threadpool_destroy(p);
+}
+
+void TestThreadPoolReuse(CuTest *c)
+{
+    static size_t runs[CSC_POOL_TASKS];
+    cthreadpool* p = csc_threadpool_create(4);
+
+    // every run hands each task to exactly one thread, and the pool survives many runs.
+    for (size_t round = 1; round <= 100; ++round) {
+        csc_threadpool_run(p, CSC_POOL_TASKS, _record_task, runs);
+        for (size_t i = 0; i < CSC_POOL_TASKS; ++i) {
+            CuAssertIntEquals(c, round, runs[i]);
+        }
+    }
+
+    // fewer tasks than threads.
+    csc_threadpool_run(p, 2, _record_task, runs);
+    CuAssertIntEquals(c, 101, runs[1]);
+    CuAssertIntEquals(c, 100, runs[2]);
+    csc_threadpool_run(p, 0, _record_task, runs);
+
+    csc_threadpool_destroy(p);
+}
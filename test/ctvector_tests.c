@@ -0,0 +1,146 @@
+#include "CuTest.h"
+#include "ctvector.h"
+#include "test_alloc.h"
+
+CSC_CVECTOR_DEFINE(int, intvec)
+
+typedef struct _pair {
+    int key;
+    int value;
+} _pair;
+
+#define _PAIR_EQ(a, b) ((a).key == (b).key)
+
+CSC_CVECTOR_DEFINE_EQ(_pair, pairvec, _PAIR_EQ)
+
+void TestTypedVectorInit(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    CuAssertIntEquals(c, 0, csc_intvec_size(v));
+    CuAssertIntEquals(c, 0, csc_intvec_capacity(v));
+    CuAssertTrue(c, csc_intvec_empty(v));
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorAddAndAt(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    for (int i = 0; i < 50; i++) {
+        CuAssertTrue(c, csc_intvec_add(v, i) == E_NOERR);
+    }
+
+    CuAssertIntEquals(c, 50, csc_intvec_size(v));
+    for (int i = 0; i < 50; i++) {
+        CuAssertIntEquals(c, i, *csc_intvec_at(v, i));
+    }
+    CuAssertPtrEquals(c, NULL, csc_intvec_at(v, 50));
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorFind(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    for (int i = 0; i < 5; i++) {
+        csc_intvec_add(v, i);
+    }
+
+    CuAssertPtrEquals(c, csc_intvec_at(v, 2), csc_intvec_find(v, 2));
+    CuAssertPtrEquals(c, NULL, csc_intvec_find(v, 7));
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorRm(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    for (int i = 0; i < 5; i++) {
+        csc_intvec_add(v, i);
+    }
+
+    CuAssertTrue(c, csc_intvec_rm(v, 1));
+    CuAssertTrue(c, !csc_intvec_rm(v, 1));
+    CuAssertIntEquals(c, 4, csc_intvec_size(v));
+    CuAssertPtrEquals(c, NULL, csc_intvec_find(v, 1));
+
+    int out = -1;
+    CuAssertTrue(c, csc_intvec_rm_at(v, 0, &out) == E_NOERR);
+    CuAssertIntEquals(c, 0, out);
+    CuAssertTrue(c, csc_intvec_rm_at(v, 3, &out) == E_OUTOFRANGE);
+    CuAssertIntEquals(c, 3, csc_intvec_size(v));
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorReserveAndShrink(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    CuAssertTrue(c, csc_intvec_reserve(v, 100) == E_NOERR);
+    CuAssertIntEquals(c, 100, csc_intvec_capacity(v));
+
+    csc_intvec_add(v, 1);
+    CuAssertTrue(c, csc_intvec_shrink_to_fit(v) == E_NOERR);
+    CuAssertIntEquals(c, 1, csc_intvec_capacity(v));
+    CuAssertTrue(c, csc_intvec_reserve(v, 0) == E_INVALIDOPERATION);
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorGrowFromCapacityOne(CuTest* c)
+{
+    intvec* v = csc_intvec_create();
+
+    // half of a capacity of 1 is 0 so growth must still add at least one slot.
+    CuAssertTrue(c, csc_intvec_reserve(v, 1) == E_NOERR);
+    CuAssertTrue(c, csc_intvec_add(v, 1) == E_NOERR);
+    CuAssertTrue(c, csc_intvec_add(v, 2) == E_NOERR);
+    CuAssertTrue(c, csc_intvec_capacity(v) >= 2);
+    CuAssertIntEquals(c, 2, *csc_intvec_at(v, 1));
+
+    csc_intvec_destroy(v);
+}
+
+void TestTypedVectorCustomEq(CuTest* c)
+{
+    pairvec* v = csc_pairvec_create();
+
+    for (int i = 0; i < 5; i++) {
+        _pair p = { .key = i, .value = i * 10 };
+        csc_pairvec_add(v, p);
+    }
+
+    _pair needle = { .key = 3, .value = 0 };
+    _pair* found = csc_pairvec_find(v, needle);
+    CuAssertPtrNotNull(c, found);
+    CuAssertIntEquals(c, 30, found->value);
+
+    csc_pairvec_destroy(v);
+}
+
+void TestTypedVectorCreateWithAllocator(CuTest* c)
+{
+    _alloc_stats stats = {0, 0, 0};
+    const csc_allocator a = { _counting_alloc, _counting_realloc, _counting_free, &stats };
+
+    intvec* v = csc_intvec_create_with_allocator(&a);
+    for (int i = 0; i < 100; i++) {
+        csc_intvec_add(v, i);
+    }
+    CuAssertIntEquals(c, 99, *csc_intvec_at(v, 99));
+    CuAssertTrue(c, stats.allocs == 2);
+    CuAssertTrue(c, stats.bytes == sizeof(intvec) + csc_intvec_capacity(v) * sizeof(int));
+
+    CuAssertTrue(c, csc_intvec_shrink_to_fit(v) == E_NOERR);
+    CuAssertTrue(c, stats.bytes == sizeof(intvec) + 100 * sizeof(int));
+
+    csc_intvec_destroy(v);
+
+    CuAssertTrue(c, stats.frees == stats.allocs);
+    CuAssertTrue(c, stats.bytes == 0);
+}
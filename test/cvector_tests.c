@@ -1,5 +1,7 @@
 #include "CuTest.h"
 #include "cvector.h"
+#include "test_alloc.h"
+#include <stdio.h>
 
 void TestVectorInitNullAlloc(CuTest *c)
 {
@@ -262,4 +264,907 @@ void TestVectorShrinkToFit(CuTest* c)
         free(x);
     }
     csc_cvector_destroy(v);
-}
\ No newline at end of file
+}
+void TestVectorSizedInitZeroSize(CuTest* c)
+{
+    CuAssertPtrEquals(c, NULL, csc_cvector_create_sized(0));
+}
+
+void TestVectorSizedAddAndAt(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        CuAssertTrue(c, csc_cvector_add(v, &i) == E_NOERR);
+    }
+
+    CuAssertIntEquals(c, 100, csc_cvector_size(v));
+    CuAssertIntEquals(c, sizeof(int), csc_cvector_elem_size(v));
+    for (int i = 0; i < 100; i++) {
+        int* x = (int*) csc_cvector_at(v, i);
+        CuAssertIntEquals(c, i, *x);
+    }
+    CuAssertPtrEquals(c, NULL, csc_cvector_at(v, 100));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSizedFind(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 5; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    int x = 3;
+    CuAssertPtrEquals(c, csc_cvector_at(v, 3), csc_cvector_find(v, &x, csc_cmp_int));
+    x = 5;
+    CuAssertPtrEquals(c, NULL, csc_cvector_find(v, &x, csc_cmp_int));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSizedRm(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 5; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    int x = 1;
+    int* ret = (int*) csc_cvector_rm(v, &x, csc_cmp_int);
+
+    CuAssertIntEquals(c, 1, *ret);
+    CuAssertIntEquals(c, 4, csc_cvector_size(v));
+    CuAssertPtrEquals(c, NULL, csc_cvector_find(v, &x, csc_cmp_int));
+    CuAssertIntEquals(c, 4, *(int*) csc_cvector_at(v, 1));
+
+    ret = (int*) csc_cvector_rm_at(v, 0);
+    CuAssertIntEquals(c, 0, *ret);
+    CuAssertIntEquals(c, 3, csc_cvector_size(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorRmReturnsRemovedElement(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x[] = {1, 2, 3};
+    for (int i = 0; i < 3; i++) {
+        csc_cvector_add(v, &x[i]);
+    }
+
+    CuAssertPtrEquals(c, &x[0], csc_cvector_rm(v, &x[0], csc_cmp_int));
+    CuAssertIntEquals(c, 2, csc_cvector_size(v));
+    CuAssertPtrEquals(c, NULL, csc_cvector_find(v, &x[0], csc_cmp_int));
+    CuAssertPtrEquals(c, &x[2], csc_cvector_find(v, &x[2], csc_cmp_int));
+
+    csc_cvector_destroy(v);
+}
+
+typedef struct _point {
+    int x;
+    int y;
+} _point;
+
+static void _sum_points(void* elem, void* context)
+{
+    _point* p = (_point*)elem;
+    int* sum = (int*)context;
+    *sum += p->x + p->y;
+}
+
+void TestVectorSizedForEach(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(_point));
+
+    for (int i = 0; i < 10; i++) {
+        _point p = { .x = i, .y = 1 };
+        csc_cvector_add(v, &p);
+    }
+
+    int sum = 0;
+    csc_cvector_foreach(v, _sum_points, &sum);
+    CuAssertIntEquals(c, 55, sum);
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorFindInt(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    // use enough elements to exercise both the vectorized loop and the scalar tail.
+    for (int i = 0; i < 37; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    for (int i = 0; i < 37; i++) {
+        CuAssertPtrEquals(c, csc_cvector_at(v, i), csc_cvector_find_int(v, i));
+    }
+    CuAssertPtrEquals(c, NULL, csc_cvector_find_int(v, 37));
+    CuAssertPtrEquals(c, NULL, csc_cvector_find_int(v, -1));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorFindIntReturnsFirstMatch(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 32; i++) {
+        int x = i % 4;
+        csc_cvector_add(v, &x);
+    }
+
+    CuAssertPtrEquals(c, csc_cvector_at(v, 3), csc_cvector_find_int(v, 3));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorFindIntPointerStorage(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x = 5;
+    csc_cvector_add(v, &x);
+
+    CuAssertPtrEquals(c, &x, csc_cvector_find_int(v, 5));
+    CuAssertPtrEquals(c, NULL, csc_cvector_find_int(v, 6));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorIntFunctionsRejectOtherSizes(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(long long));
+
+    long long x = 1;
+    csc_cvector_add(v, &x);
+
+    // the element size is checked at runtime so release builds don't scan with the wrong stride.
+    CuAssertPtrEquals(c, NULL, csc_cvector_find_int(v, 1));
+    CuAssertTrue(c, csc_cvector_sort_int(v) == E_INVALIDOPERATION);
+    CuAssertTrue(c, *(long long*) csc_cvector_at(v, 0) == 1);
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorAddN(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x[] = {1, 2, 3};
+    void* elems[] = {&x[0], &x[1], &x[2]};
+
+    csc_cvector_add(v, &x[0]);
+    CuAssertTrue(c, csc_cvector_add_n(v, elems, 3) == E_NOERR);
+
+    CuAssertIntEquals(c, 4, csc_cvector_size(v));
+    CuAssertPtrEquals(c, &x[0], csc_cvector_at(v, 1));
+    CuAssertPtrEquals(c, &x[2], csc_cvector_at(v, 3));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSizedAddN(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[50];
+    for (int i = 0; i < 50; i++) {
+        elems[i] = i;
+    }
+
+    CuAssertTrue(c, csc_cvector_add_n(v, elems, 50) == E_NOERR);
+    CuAssertTrue(c, csc_cvector_add_n(v, elems, 50) == E_NOERR);
+
+    CuAssertIntEquals(c, 100, csc_cvector_size(v));
+    CuAssertIntEquals(c, 49, *(int*) csc_cvector_at(v, 49));
+    CuAssertIntEquals(c, 0, *(int*) csc_cvector_at(v, 50));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorCreateFrom(CuTest* c)
+{
+    int x[] = {1, 2, 3};
+    void* elems[] = {&x[0], &x[1], &x[2]};
+
+    cvector* v = csc_cvector_create_from(elems, 3);
+
+    CuAssertIntEquals(c, 3, csc_cvector_size(v));
+    CuAssertPtrEquals(c, &x[1], csc_cvector_at(v, 1));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorAdopt(CuTest* c)
+{
+    int x[] = {1, 2};
+    void** buffer = malloc(4 * sizeof(*buffer));
+    buffer[0] = &x[0];
+    buffer[1] = &x[1];
+
+    cvector* v = csc_cvector_adopt(buffer, 2, 4);
+
+    CuAssertIntEquals(c, 2, csc_cvector_size(v));
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+    CuAssertPtrEquals(c, &x[1], csc_cvector_at(v, 1));
+
+    csc_cvector_add(v, &x[0]);
+    CuAssertIntEquals(c, 3, csc_cvector_size(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorAdoptSizeGreaterThanCapacity(CuTest* c)
+{
+    void* buffer[1] = {NULL};
+
+    CuAssertPtrEquals(c, NULL, csc_cvector_adopt(buffer, 2, 1));
+}
+
+static bool _is_sorted_int(const cvector* v)
+{
+    for (size_t i = 1; i < csc_cvector_size(v); i++) {
+        if (*(int*) csc_cvector_at(v, i - 1) > *(int*) csc_cvector_at(v, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestVectorSortPointers(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x[200];
+    for (int i = 0; i < 200; i++) {
+        x[i] = (i * 7919) % 200;
+        csc_cvector_add(v, &x[i]);
+    }
+
+    csc_cvector_sort(v, csc_cmp_int);
+
+    CuAssertIntEquals(c, 200, csc_cvector_size(v));
+    CuAssertTrue(c, _is_sorted_int(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSortSizedWithDuplicates(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 1000; i++) {
+        int x = (i * 31) % 17;
+        csc_cvector_add(v, &x);
+    }
+
+    csc_cvector_sort(v, csc_cmp_int);
+
+    CuAssertTrue(c, _is_sorted_int(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSortAlreadySorted(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 1000; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    csc_cvector_sort(v, csc_cmp_int);
+
+    CuAssertTrue(c, _is_sorted_int(v));
+    CuAssertIntEquals(c, 999, *(int*) csc_cvector_at(v, 999));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSortInt(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    unsigned seed = 1;
+    for (int i = 0; i < 5000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int x = (int)seed;
+        csc_cvector_add(v, &x);
+    }
+
+    CuAssertTrue(c, csc_cvector_sort_int(v) == E_NOERR);
+
+    CuAssertIntEquals(c, 5000, csc_cvector_size(v));
+    CuAssertTrue(c, _is_sorted_int(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSortIntSmall(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[] = {3, -1, 2, -7, 0};
+    csc_cvector_add_n(v, elems, 5);
+
+    CuAssertTrue(c, csc_cvector_sort_int(v) == E_NOERR);
+
+    CuAssertTrue(c, _is_sorted_int(v));
+    CuAssertIntEquals(c, -7, *(int*) csc_cvector_at(v, 0));
+
+    csc_cvector_destroy(v);
+}
+
+static void _double_elem(void* elem, void* context)
+{
+    CSC_UNUSED(context);
+    int* x = (int*)elem;
+    *x *= 2;
+}
+
+void TestVectorParallelForEach(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 1001; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    csc_cvector_parallel_foreach(v, _double_elem, NULL, 4);
+
+    for (int i = 0; i < 1001; i++) {
+        CuAssertIntEquals(c, 2 * i, *(int*) csc_cvector_at(v, i));
+    }
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorParallelSort(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    unsigned seed = 7;
+    for (int i = 0; i < 50000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int x = (int)(seed % 100000);
+        csc_cvector_add(v, &x);
+    }
+
+    // an odd thread count exercises merging an unpaired run.
+    CuAssertTrue(c, csc_cvector_parallel_sort(v, csc_cmp_int, 3) == E_NOERR);
+
+    CuAssertIntEquals(c, 50000, csc_cvector_size(v));
+    CuAssertTrue(c, _is_sorted_int(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorParallelSortPointers(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int* x = malloc(10000 * sizeof(*x));
+    for (int i = 0; i < 10000; i++) {
+        x[i] = 10000 - i;
+        csc_cvector_add(v, &x[i]);
+    }
+
+    CuAssertTrue(c, csc_cvector_parallel_sort(v, csc_cmp_int, 0) == E_NOERR);
+    CuAssertTrue(c, _is_sorted_int(v));
+
+    csc_cvector_destroy(v);
+    free(x);
+}
+
+void TestVectorParallelWithPool(CuTest* c)
+{
+    cthreadpool* p = csc_threadpool_create(3);
+
+    // the same threads serve every call.
+    for (int round = 0; round < 3; round++) {
+        cvector* v = csc_cvector_create_sized(sizeof(int));
+        for (int i = 0; i < 20000; i++) {
+            int x = (i * 7919 + round) % 20000;
+            csc_cvector_add(v, &x);
+        }
+        CuAssertTrue(c, csc_cvector_parallel_sort_with_pool(v, csc_cmp_int, p) == E_NOERR);
+        CuAssertTrue(c, _is_sorted_int(v));
+
+        csc_cvector_parallel_foreach_with_pool(v, _double_elem, NULL, p);
+        CuAssertIntEquals(c, 2 * 19999, *(int*) csc_cvector_at(v, 19999));
+
+        csc_cvector_destroy(v);
+    }
+
+    csc_threadpool_destroy(p);
+}
+
+void TestVectorInsert(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[] = {1, 3};
+    csc_cvector_add_n(v, elems, 2);
+
+    int x = 2;
+    CuAssertTrue(c, csc_cvector_insert(v, 1, &x) == E_NOERR);
+    x = 0;
+    CuAssertTrue(c, csc_cvector_insert(v, 0, &x) == E_NOERR);
+    x = 4;
+    CuAssertTrue(c, csc_cvector_insert(v, 4, &x) == E_NOERR);
+    CuAssertTrue(c, csc_cvector_insert(v, 6, &x) == E_OUTOFRANGE);
+
+    CuAssertIntEquals(c, 5, csc_cvector_size(v));
+    for (int i = 0; i < 5; i++) {
+        CuAssertIntEquals(c, i, *(int*) csc_cvector_at(v, i));
+    }
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorBounds(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[] = {1, 2, 2, 2, 5, 7};
+    csc_cvector_add_n(v, elems, 6);
+
+    int x = 2;
+    CuAssertIntEquals(c, 1, csc_cvector_lower_bound(v, &x, csc_cmp_int));
+    CuAssertIntEquals(c, 4, csc_cvector_upper_bound(v, &x, csc_cmp_int));
+    x = 0;
+    CuAssertIntEquals(c, 0, csc_cvector_lower_bound(v, &x, csc_cmp_int));
+    x = 6;
+    CuAssertIntEquals(c, 5, csc_cvector_lower_bound(v, &x, csc_cmp_int));
+    x = 8;
+    CuAssertIntEquals(c, 6, csc_cvector_lower_bound(v, &x, csc_cmp_int));
+    CuAssertIntEquals(c, 6, csc_cvector_upper_bound(v, &x, csc_cmp_int));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorBoundsEmpty(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int x = 1;
+    CuAssertIntEquals(c, 0, csc_cvector_lower_bound(v, &x, csc_cmp_int));
+    CuAssertIntEquals(c, 0, csc_cvector_upper_bound(v, &x, csc_cmp_int));
+    CuAssertPtrEquals(c, NULL, csc_cvector_bsearch(v, &x, csc_cmp_int));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorBSearch(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x[] = {1, 3, 5, 7, 9};
+    for (int i = 0; i < 5; i++) {
+        csc_cvector_add(v, &x[i]);
+    }
+
+    for (int i = 0; i < 5; i++) {
+        CuAssertPtrEquals(c, &x[i], csc_cvector_bsearch(v, &x[i], csc_cmp_int));
+    }
+    int y = 4;
+    CuAssertPtrEquals(c, NULL, csc_cvector_bsearch(v, &y, csc_cmp_int));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorRmAtOrdered(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[] = {0, 1, 2, 3, 4};
+    csc_cvector_add_n(v, elems, 5);
+
+    int* ret = (int*) csc_cvector_rm_at_ordered(v, 1);
+    CuAssertIntEquals(c, 1, *ret);
+    CuAssertPtrEquals(c, NULL, csc_cvector_rm_at_ordered(v, 4));
+
+    CuAssertIntEquals(c, 4, csc_cvector_size(v));
+    CuAssertIntEquals(c, 0, *(int*) csc_cvector_at(v, 0));
+    CuAssertIntEquals(c, 2, *(int*) csc_cvector_at(v, 1));
+    CuAssertIntEquals(c, 4, *(int*) csc_cvector_at(v, 3));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorRmAtOrderedPointers(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x[] = {0, 1, 2};
+    for (int i = 0; i < 3; i++) {
+        csc_cvector_add(v, &x[i]);
+    }
+
+    CuAssertPtrEquals(c, &x[0], csc_cvector_rm_at_ordered(v, 0));
+    CuAssertPtrEquals(c, &x[1], csc_cvector_at(v, 0));
+    CuAssertPtrEquals(c, &x[2], csc_cvector_at(v, 1));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorRmRange(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    int elems[] = {0, 1, 2, 3, 4};
+    csc_cvector_add_n(v, elems, 5);
+
+    CuAssertTrue(c, csc_cvector_rm_range(v, 3, 2) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_cvector_rm_range(v, 0, 6) == E_OUTOFRANGE);
+    CuAssertTrue(c, csc_cvector_rm_range(v, 1, 3) == E_NOERR);
+
+    CuAssertIntEquals(c, 3, csc_cvector_size(v));
+    CuAssertIntEquals(c, 0, *(int*) csc_cvector_at(v, 0));
+    CuAssertIntEquals(c, 3, *(int*) csc_cvector_at(v, 1));
+    CuAssertIntEquals(c, 4, *(int*) csc_cvector_at(v, 2));
+
+    csc_cvector_destroy(v);
+}
+
+static bool _is_odd(const void* elem, void* context)
+{
+    int* calls = (int*)context;
+    ++*calls;
+    return (*(const int*)elem % 2) != 0;
+}
+
+void TestVectorEraseIf(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 10; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    int calls = 0;
+    CuAssertIntEquals(c, 5, csc_cvector_erase_if(v, _is_odd, &calls));
+
+    CuAssertIntEquals(c, 10, calls);
+    CuAssertIntEquals(c, 5, csc_cvector_size(v));
+    for (int i = 0; i < 5; i++) {
+        CuAssertIntEquals(c, 2 * i, *(int*) csc_cvector_at(v, i));
+    }
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorCreateWithAllocator(CuTest* c)
+{
+    _alloc_stats stats = {0, 0, 0};
+    const csc_allocator a = { _counting_alloc, _counting_realloc, _counting_free, &stats };
+
+    cvector* v = csc_cvector_create_sized_with_allocator(sizeof(int), &a);
+    for (int i = 0; i < 100; i++) {
+        csc_cvector_add(v, &i);
+    }
+    CuAssertIntEquals(c, 99, *(int*) csc_cvector_at(v, 99));
+    CuAssertTrue(c, stats.allocs == 2);
+    CuAssertTrue(c, stats.bytes >= 100 * sizeof(int));
+
+    csc_cvector_destroy(v);
+
+    CuAssertTrue(c, stats.frees == stats.allocs);
+    CuAssertTrue(c, stats.bytes == 0);
+}
+
+void TestVectorCreateWithCapacity(CuTest* c)
+{
+    cvector* v = csc_cvector_create_with_capacity(50);
+
+    CuAssertIntEquals(c, 0, csc_cvector_size(v));
+    CuAssertIntEquals(c, 50, csc_cvector_capacity(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorConstructorsWithAllocator(CuTest* c)
+{
+    _alloc_stats stats = {0, 0, 0};
+    const csc_allocator a = { _counting_alloc, _counting_realloc, _counting_free, &stats };
+
+    cvector* v = csc_cvector_create_with_capacity_with_allocator(50, &a);
+    CuAssertIntEquals(c, 50, csc_cvector_capacity(v));
+    CuAssertTrue(c, stats.allocs == 2);
+    csc_cvector_destroy(v);
+    CuAssertTrue(c, stats.bytes == 0);
+
+    int x[] = {1, 2, 3};
+    void* elems[] = {&x[0], &x[1], &x[2]};
+    v = csc_cvector_create_from_with_allocator(elems, 3, &a);
+    CuAssertPtrEquals(c, &x[2], csc_cvector_at(v, 2));
+    csc_cvector_destroy(v);
+
+    v = csc_cvector_create_sized_small_with_allocator(sizeof(int), 4, &a);
+    for (int i = 0; i < 8; i++) {
+        csc_cvector_add(v, &i);
+    }
+    CuAssertIntEquals(c, 7, *(int*) csc_cvector_at(v, 7));
+    csc_cvector_destroy(v);
+
+    // the adopted buffer is released through the allocator that allocated it.
+    void** buffer = _counting_alloc(4 * sizeof(void*), &stats);
+    buffer[0] = &x[0];
+    v = csc_cvector_adopt_with_allocator(buffer, 1, 4, &a);
+    for (int i = 0; i < 10; i++) {
+        csc_cvector_add(v, &x[1]);
+    }
+    CuAssertPtrEquals(c, &x[0], csc_cvector_at(v, 0));
+    csc_cvector_destroy(v);
+
+    CuAssertTrue(c, stats.frees == stats.allocs);
+    CuAssertTrue(c, stats.bytes == 0);
+}
+
+void TestVectorDefaultGrowth(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    int x = 0;
+    csc_cvector_add(v, &x);
+    CuAssertIntEquals(c, 10, csc_cvector_capacity(v));
+
+    for (int i = 0; i < 10; i++) {
+        csc_cvector_add(v, &x);
+    }
+    CuAssertIntEquals(c, 15, csc_cvector_capacity(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorCreateWithGrowth(CuTest* c)
+{
+    const csc_cvector_growth doubling = { .initial = 4, .factor_percent = 200, .min_step = 0, .page_size = 0 };
+    cvector* v = csc_cvector_create_sized_with_growth(sizeof(int), &doubling);
+
+    int x = 0;
+    csc_cvector_add(v, &x);
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+    for (int i = 0; i < 4; i++) {
+        csc_cvector_add(v, &x);
+    }
+    CuAssertIntEquals(c, 8, csc_cvector_capacity(v));
+    csc_cvector_destroy(v);
+
+    v = csc_cvector_create_with_growth(&doubling);
+    csc_cvector_add(v, &x);
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+    csc_cvector_destroy(v);
+
+    const csc_cvector_growth shrinking = { .initial = 4, .factor_percent = 50, .min_step = 0, .page_size = 0 };
+    CuAssertPtrEquals(c, NULL, csc_cvector_create_with_growth(&shrinking));
+    CuAssertPtrEquals(c, NULL, csc_cvector_create_sized_with_growth(0, &doubling));
+}
+
+void TestVectorSetGrowth(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    const csc_cvector_growth doubling = { .initial = 4, .factor_percent = 200, .min_step = 0, .page_size = 0 };
+    CuAssertTrue(c, csc_cvector_set_growth(v, &doubling) == E_NOERR);
+
+    for (int i = 0; i < 5; i++) {
+        csc_cvector_add(v, &i);
+    }
+    CuAssertIntEquals(c, 8, csc_cvector_capacity(v));
+
+    const csc_cvector_growth stepped = { .initial = 4, .factor_percent = 100, .min_step = 100, .page_size = 0 };
+    CuAssertTrue(c, csc_cvector_set_growth(v, &stepped) == E_NOERR);
+    for (int i = 0; i < 4; i++) {
+        csc_cvector_add(v, &i);
+    }
+    CuAssertIntEquals(c, 108, csc_cvector_capacity(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSetGrowthPageRounding(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(3);
+
+    const csc_cvector_growth paged = { .initial = 1000, .factor_percent = 150, .min_step = 0, .page_size = 4096 };
+    CuAssertTrue(c, csc_cvector_set_growth(v, &paged) == E_NOERR);
+
+    char elem[3] = {0};
+    csc_cvector_add(v, elem);
+    CuAssertIntEquals(c, 1000, csc_cvector_capacity(v));
+
+    for (int i = 0; i < 1000; i++) {
+        csc_cvector_add(v, elem);
+    }
+    // 1500 elements is 4500 bytes which rounds up to 8192 bytes.
+    CuAssertIntEquals(c, 8192 / 3, csc_cvector_capacity(v));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSetGrowthInvalid(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    const csc_cvector_growth shrinking = { .initial = 10, .factor_percent = 50, .min_step = 0, .page_size = 0 };
+    CuAssertTrue(c, csc_cvector_set_growth(v, &shrinking) == E_INVALIDOPERATION);
+    const csc_cvector_growth empty = { .initial = 0, .factor_percent = 150, .min_step = 0, .page_size = 0 };
+    CuAssertTrue(c, csc_cvector_set_growth(v, &empty) == E_INVALIDOPERATION);
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorIterator(CuTest* c)
+{
+    cvector* v = csc_cvector_create();
+
+    csc_cvector_iter it = csc_cvector_iter_begin(v);
+    CuAssertTrue(c, !csc_cvector_iter_valid(&it));
+
+    int input[] = {1, 2, 3, 4, 5};
+    for (unsigned i = 0; i < sizeof(input) / sizeof(int); i++) {
+        csc_cvector_add(v, &input[i]);
+    }
+
+    unsigned n = 0;
+    for (it = csc_cvector_iter_begin(v); csc_cvector_iter_valid(&it); csc_cvector_iter_next(&it)) {
+        CuAssertPtrEquals(c, &input[n], csc_cvector_iter_get(&it));
+        n++;
+    }
+    CuAssertIntEquals(c, 5, n);
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorIteratorSized(CuTest* c)
+{
+    cvector* v = csc_cvector_create_sized(sizeof(int));
+
+    for (int i = 0; i < 5; i++) {
+        csc_cvector_add(v, &i);
+    }
+
+    int expected = 0;
+    for (csc_cvector_iter it = csc_cvector_iter_begin(v); csc_cvector_iter_valid(&it); csc_cvector_iter_next(&it)) {
+        int* x = csc_cvector_iter_get(&it);
+        CuAssertPtrEquals(c, csc_cvector_at(v, expected), x);
+        if (*x == 3) {
+            break;
+        }
+        expected++;
+    }
+    CuAssertIntEquals(c, 3, expected);
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorMappedPersists(CuTest* c)
+{
+    const char* path = "csc_cvector_mapped_test.bin";
+    remove(path);
+
+    CSCError e = E_ERR_N;
+    cvector* v = csc_cvector_open_mapped(path, sizeof(int), &e);
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertIntEquals(c, 0, csc_cvector_size(v));
+    CuAssertIntEquals(c, sizeof(int), csc_cvector_elem_size(v));
+
+    for (int i = 0; i < 1000; i++) {
+        CuAssertTrue(c, csc_cvector_add(v, &i) == E_NOERR);
+    }
+    CuAssertTrue(c, csc_cvector_sync(v) == E_NOERR);
+    csc_cvector_destroy(v);
+
+    v = csc_cvector_open_mapped(path, sizeof(int), &e);
+    CuAssertTrue(c, e == E_NOERR);
+    CuAssertIntEquals(c, 1000, csc_cvector_size(v));
+    for (int i = 0; i < 1000; i++) {
+        CuAssertIntEquals(c, i, *(int*)csc_cvector_at(v, i));
+    }
+
+    // the count is also recorded when the vector is destroyed.
+    csc_cvector_rm_range(v, 10, 1000);
+    CuAssertTrue(c, csc_cvector_shrink_to_fit(v) == E_NOERR);
+    csc_cvector_destroy(v);
+
+    v = csc_cvector_open_mapped(path, sizeof(int), NULL);
+    CuAssertIntEquals(c, 10, csc_cvector_size(v));
+    CuAssertIntEquals(c, 10, csc_cvector_capacity(v));
+    CuAssertIntEquals(c, 9, *(int*)csc_cvector_at(v, 9));
+    csc_cvector_destroy(v);
+
+    remove(path);
+}
+
+void TestVectorMappedRejectsMismatch(CuTest* c)
+{
+    const char* path = "csc_cvector_mapped_mismatch.bin";
+    remove(path);
+
+    cvector* v = csc_cvector_open_mapped(path, sizeof(int), NULL);
+    int x = 5;
+    csc_cvector_add(v, &x);
+    csc_cvector_destroy(v);
+
+    // different element size
+    CSCError e = E_NOERR;
+    CuAssertPtrEquals(c, NULL, csc_cvector_open_mapped(path, sizeof(double), &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    // corrupt magic
+    FILE* f = fopen(path, "r+b");
+    fputs("garbage", f);
+    fclose(f);
+    CuAssertPtrEquals(c, NULL, csc_cvector_open_mapped(path, sizeof(int), &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    // truncated header
+    f = fopen(path, "wb");
+    fputs("CSC", f);
+    fclose(f);
+    CuAssertPtrEquals(c, NULL, csc_cvector_open_mapped(path, sizeof(int), &e));
+    CuAssertTrue(c, e == E_INVALIDOPERATION);
+
+    remove(path);
+
+    // heap vectors can't be synced.
+    v = csc_cvector_create_sized(sizeof(int));
+    CuAssertTrue(c, csc_cvector_sync(v) == E_INVALIDOPERATION);
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSmallSingleAllocation(CuTest* c)
+{
+    cvector* v = csc_cvector_create_small(4);
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+
+    int input[] = {1, 2, 3, 4, 5, 6};
+    for (unsigned i = 0; i < 4; i++) {
+        csc_cvector_add(v, &input[i]);
+    }
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+
+    // spill to the heap
+    csc_cvector_add(v, &input[4]);
+    csc_cvector_add(v, &input[5]);
+    CuAssertTrue(c, csc_cvector_capacity(v) > 4);
+    for (unsigned i = 0; i < 6; i++) {
+        CuAssertPtrEquals(c, &input[i], csc_cvector_at(v, i));
+    }
+
+    // move back inline
+    csc_cvector_rm_range(v, 2, 6);
+    CuAssertTrue(c, csc_cvector_shrink_to_fit(v) == E_NOERR);
+    CuAssertIntEquals(c, 4, csc_cvector_capacity(v));
+    CuAssertPtrEquals(c, &input[0], csc_cvector_at(v, 0));
+    CuAssertPtrEquals(c, &input[1], csc_cvector_at(v, 1));
+
+    csc_cvector_destroy(v);
+}
+
+void TestVectorSizedSmall(CuTest* c)
+{
+    CuAssertPtrEquals(c, NULL, csc_cvector_create_sized_small(0, 8));
+
+    cvector* v = csc_cvector_create_sized_small(sizeof(double), 8);
+    CuAssertIntEquals(c, sizeof(double), csc_cvector_elem_size(v));
+
+    for (int i = 0; i < 20; i++) {
+        double d = i * 0.5;
+        csc_cvector_add(v, &d);
+    }
+    CuAssertIntEquals(c, 20, csc_cvector_size(v));
+    for (int i = 0; i < 20; i++) {
+        CuAssertDblEquals(c, i * 0.5, *(double*)csc_cvector_at(v, i), 0.0);
+    }
+
+    csc_cvector_destroy(v);
+}
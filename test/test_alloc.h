@@ -0,0 +1,40 @@
+#pragma once
+
+/*
+ * A csc_allocator that forwards to malloc, realloc and free while counting the blocks and bytes it hands out, so
+ * tests can check that containers route every allocation through their allocator and release everything.
+ */
+
+#include "csc.h"
+#include <stdlib.h>
+
+typedef struct _alloc_stats {
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+} _alloc_stats;
+
+static inline void* _counting_alloc(size_t size, void* context)
+{
+    _alloc_stats* stats = (_alloc_stats*)context;
+    ++stats->allocs;
+    stats->bytes += size;
+    return malloc(size);
+}
+
+static inline void* _counting_realloc(void* ptr, size_t old_size, size_t new_size, void* context)
+{
+    _alloc_stats* stats = (_alloc_stats*)context;
+    stats->bytes += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static inline void _counting_free(void* ptr, size_t size, void* context)
+{
+    _alloc_stats* stats = (_alloc_stats*)context;
+    if (ptr != NULL) {
+        ++stats->frees;
+        stats->bytes -= size;
+    }
+    free(ptr);
+}
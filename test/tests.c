@@ -0,0 +1,335 @@
+
+
+/* This is auto-generated code. Edit at your own peril. */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+
+
+extern void TestAtomicBitSetConstruction(CuTest*);
+extern void TestAtomicBitSetTestAndSet(CuTest*);
+extern void TestAtomicBitSetClaim(CuTest*);
+extern void TestAtomicBitSetConcurrentClaim(CuTest*);
+extern void TestBitmapCreate(CuTest*);
+extern void TestBitmapSetClear(CuTest*);
+extern void TestBitmapDenseChunk(CuTest*);
+extern void TestBitmapOptimizeRuns(CuTest*);
+extern void TestBitmapOrAnd(CuTest*);
+extern void TestBitmapForEach(CuTest*);
+extern void TestBitSetConstruction(CuTest*);
+extern void TestBitSetConstructionZeroSize(CuTest*);
+extern void TestBitSetAccess(CuTest*);
+extern void TestBitSetAccessOutofRange(CuTest*);
+extern void TestBitSetSetBit(CuTest*);
+extern void TestBitSetSetBitOutOfRange(CuTest*);
+extern void TestBitSetClearBit(CuTest*);
+extern void TestBitSetClearBitOutOfRange(CuTest*);
+extern void TestBitSetFlipBit(CuTest*);
+extern void TestBitSetFlipBitOutOfRange(CuTest*);
+extern void TestBitSetSetAll(CuTest*);
+extern void TestBitSetClearAll(CuTest*);
+extern void TestBitSetCreateWithAllocator(CuTest*);
+extern void TestBitSetHighBits(CuTest*);
+extern void TestBitSetIterator(CuTest*);
+extern void TestBitSetRangeOps(CuTest*);
+extern void TestBitSetWords(CuTest*);
+extern void TestBitSetCountRankSelect(CuTest*);
+extern void TestBitSetSetAlgebra(CuTest*);
+extern void TestBitSetSubsetAndIntersects(CuTest*);
+extern void TestBitSetFindNext(CuTest*);
+extern void TestBitSetForEach(CuTest*);
+extern void TestBitSetResize(CuTest*);
+extern void TestBitSetSerialize(CuTest*);
+extern void TestBitSetView(CuTest*);
+extern void TestBloomCreate(CuTest*);
+extern void TestBloomFalsePositiveRate(CuTest*);
+extern void TestBloomBlocked(CuTest*);
+extern void TestBloomHash(CuTest*);
+extern void TestBloomUnion(CuTest*);
+extern void TestBloomSerialize(CuTest*);
+extern void TestBloomDeserializeRejectsHashCount(CuTest*);
+extern void TestBloomDistinctProbes(CuTest*);
+extern void TestBSTCreate(CuTest*);
+extern void TestBSTAdd(CuTest*);
+extern void TestBSTAddSameElement(CuTest*);
+extern void TestBSTFindElement(CuTest*);
+extern void TestBSTFindElementThatDoesNotExist(CuTest*);
+extern void TestBSTFindElementOnEmptyContainer(CuTest*);
+extern void TestBSTForEach(CuTest*);
+extern void TestBSTForEachInOrder(CuTest*);
+extern void TestBSTForEachReverseOrder(CuTest*);
+extern void TestBSTRemoveNodeEmptyTree(CuTest*);
+extern void TestBSTRemoveNodeNoChildren(CuTest*);
+extern void TestBSTRemoveNodeOnlyLeftChild(CuTest*);
+extern void TestBSTRemoveNodeOnlyRightChild(CuTest*);
+extern void TestBSTRemoveNodeWithTwoChildren(CuTest*);
+extern void TestBSTRemoveLeafNode(CuTest*);
+extern void TestBSTRemoveNull(CuTest*);
+extern void TestBSTCreateWithAllocator(CuTest*);
+extern void TestBSTRemoveRootWithDeepSuccessor(CuTest*);
+extern void TestBSTIterator(CuTest*);
+extern void TestBSTBalancedSortedAdd(CuTest*);
+extern void TestBSTBalancedRemove(CuTest*);
+extern void TestFlatSetCreate(CuTest*);
+extern void TestFlatSetCreateSizedZeroSize(CuTest*);
+extern void TestFlatSetAddKeepsOrder(CuTest*);
+extern void TestFlatSetAddDuplicate(CuTest*);
+extern void TestFlatSetFind(CuTest*);
+extern void TestFlatSetRm(CuTest*);
+extern void TestHBitSetConstruction(CuTest*);
+extern void TestHBitSetSetClear(CuTest*);
+extern void TestHBitSetFindNext(CuTest*);
+extern void TestHBitSetForEach(CuTest*);
+extern void TestSoaCreate(CuTest*);
+extern void TestSoaCreateInvalid(CuTest*);
+extern void TestSoaAddAndScan(CuTest*);
+extern void TestSoaRemoveAt(CuTest*);
+extern void TestThreadPoolCreate(CuTest*);
+extern void TestThreadPoolReuse(CuTest*);
+extern void TestTypedVectorInit(CuTest*);
+extern void TestTypedVectorAddAndAt(CuTest*);
+extern void TestTypedVectorFind(CuTest*);
+extern void TestTypedVectorRm(CuTest*);
+extern void TestTypedVectorReserveAndShrink(CuTest*);
+extern void TestTypedVectorGrowFromCapacityOne(CuTest*);
+extern void TestTypedVectorCustomEq(CuTest*);
+extern void TestTypedVectorCreateWithAllocator(CuTest*);
+extern void TestVectorInitNullAlloc(CuTest*);
+extern void TestVectorAddElem(CuTest*);
+extern void TestVectorForEach(CuTest*);
+extern void TestVectorAt(CuTest*);
+extern void TestVectorAtOutOfRange(CuTest*);
+extern void TestVectorFindElementExists(CuTest*);
+extern void TestVectorFindElementDoesNotExist(CuTest*);
+extern void TestVectorRmEmpty(CuTest*);
+extern void TestVectorRmNotEmptyAndExists(CuTest*);
+extern void TestVectorRmNotEmptyAndDoesNotExist(CuTest*);
+extern void TestVectorRmAtEmpty(CuTest*);
+extern void TestVectorRmAtNotEmptyAndExists(CuTest*);
+extern void TestVectorRmAtNotEmptyAndOutOfRange(CuTest*);
+extern void TestVectorEmptyOnEmpty(CuTest*);
+extern void TestVectorEmptyOnNonEmpty(CuTest*);
+extern void TestVectorReserve(CuTest*);
+extern void TestVectorReserveLessThanElemCount(CuTest*);
+extern void TestVectorShrinkToFit(CuTest*);
+extern void TestVectorSizedInitZeroSize(CuTest*);
+extern void TestVectorSizedAddAndAt(CuTest*);
+extern void TestVectorSizedFind(CuTest*);
+extern void TestVectorSizedRm(CuTest*);
+extern void TestVectorRmReturnsRemovedElement(CuTest*);
+extern void TestVectorSizedForEach(CuTest*);
+extern void TestVectorFindInt(CuTest*);
+extern void TestVectorFindIntReturnsFirstMatch(CuTest*);
+extern void TestVectorFindIntPointerStorage(CuTest*);
+extern void TestVectorIntFunctionsRejectOtherSizes(CuTest*);
+extern void TestVectorAddN(CuTest*);
+extern void TestVectorSizedAddN(CuTest*);
+extern void TestVectorCreateFrom(CuTest*);
+extern void TestVectorAdopt(CuTest*);
+extern void TestVectorAdoptSizeGreaterThanCapacity(CuTest*);
+extern void TestVectorSortPointers(CuTest*);
+extern void TestVectorSortSizedWithDuplicates(CuTest*);
+extern void TestVectorSortAlreadySorted(CuTest*);
+extern void TestVectorSortInt(CuTest*);
+extern void TestVectorSortIntSmall(CuTest*);
+extern void TestVectorParallelForEach(CuTest*);
+extern void TestVectorParallelSort(CuTest*);
+extern void TestVectorParallelSortPointers(CuTest*);
+extern void TestVectorParallelWithPool(CuTest*);
+extern void TestVectorInsert(CuTest*);
+extern void TestVectorBounds(CuTest*);
+extern void TestVectorBoundsEmpty(CuTest*);
+extern void TestVectorBSearch(CuTest*);
+extern void TestVectorRmAtOrdered(CuTest*);
+extern void TestVectorRmAtOrderedPointers(CuTest*);
+extern void TestVectorRmRange(CuTest*);
+extern void TestVectorEraseIf(CuTest*);
+extern void TestVectorCreateWithAllocator(CuTest*);
+extern void TestVectorCreateWithCapacity(CuTest*);
+extern void TestVectorConstructorsWithAllocator(CuTest*);
+extern void TestVectorDefaultGrowth(CuTest*);
+extern void TestVectorCreateWithGrowth(CuTest*);
+extern void TestVectorSetGrowth(CuTest*);
+extern void TestVectorSetGrowthPageRounding(CuTest*);
+extern void TestVectorSetGrowthInvalid(CuTest*);
+extern void TestVectorIterator(CuTest*);
+extern void TestVectorIteratorSized(CuTest*);
+extern void TestVectorMappedPersists(CuTest*);
+extern void TestVectorMappedRejectsMismatch(CuTest*);
+extern void TestVectorSmallSingleAllocation(CuTest*);
+extern void TestVectorSizedSmall(CuTest*);
+
+
+void RunAllTests(void) 
+{
+    CuString *output = CuStringNew();
+    CuSuite* suite = CuSuiteNew();
+
+
+    SUITE_ADD_TEST(suite, TestAtomicBitSetConstruction);
+    SUITE_ADD_TEST(suite, TestAtomicBitSetTestAndSet);
+    SUITE_ADD_TEST(suite, TestAtomicBitSetClaim);
+    SUITE_ADD_TEST(suite, TestAtomicBitSetConcurrentClaim);
+    SUITE_ADD_TEST(suite, TestBitmapCreate);
+    SUITE_ADD_TEST(suite, TestBitmapSetClear);
+    SUITE_ADD_TEST(suite, TestBitmapDenseChunk);
+    SUITE_ADD_TEST(suite, TestBitmapOptimizeRuns);
+    SUITE_ADD_TEST(suite, TestBitmapOrAnd);
+    SUITE_ADD_TEST(suite, TestBitmapForEach);
+    SUITE_ADD_TEST(suite, TestBitSetConstruction);
+    SUITE_ADD_TEST(suite, TestBitSetConstructionZeroSize);
+    SUITE_ADD_TEST(suite, TestBitSetAccess);
+    SUITE_ADD_TEST(suite, TestBitSetAccessOutofRange);
+    SUITE_ADD_TEST(suite, TestBitSetSetBit);
+    SUITE_ADD_TEST(suite, TestBitSetSetBitOutOfRange);
+    SUITE_ADD_TEST(suite, TestBitSetClearBit);
+    SUITE_ADD_TEST(suite, TestBitSetClearBitOutOfRange);
+    SUITE_ADD_TEST(suite, TestBitSetFlipBit);
+    SUITE_ADD_TEST(suite, TestBitSetFlipBitOutOfRange);
+    SUITE_ADD_TEST(suite, TestBitSetSetAll);
+    SUITE_ADD_TEST(suite, TestBitSetClearAll);
+    SUITE_ADD_TEST(suite, TestBitSetCreateWithAllocator);
+    SUITE_ADD_TEST(suite, TestBitSetHighBits);
+    SUITE_ADD_TEST(suite, TestBitSetIterator);
+    SUITE_ADD_TEST(suite, TestBitSetRangeOps);
+    SUITE_ADD_TEST(suite, TestBitSetWords);
+    SUITE_ADD_TEST(suite, TestBitSetCountRankSelect);
+    SUITE_ADD_TEST(suite, TestBitSetSetAlgebra);
+    SUITE_ADD_TEST(suite, TestBitSetSubsetAndIntersects);
+    SUITE_ADD_TEST(suite, TestBitSetFindNext);
+    SUITE_ADD_TEST(suite, TestBitSetForEach);
+    SUITE_ADD_TEST(suite, TestBitSetResize);
+    SUITE_ADD_TEST(suite, TestBitSetSerialize);
+    SUITE_ADD_TEST(suite, TestBitSetView);
+    SUITE_ADD_TEST(suite, TestBloomCreate);
+    SUITE_ADD_TEST(suite, TestBloomFalsePositiveRate);
+    SUITE_ADD_TEST(suite, TestBloomBlocked);
+    SUITE_ADD_TEST(suite, TestBloomHash);
+    SUITE_ADD_TEST(suite, TestBloomUnion);
+    SUITE_ADD_TEST(suite, TestBloomSerialize);
+    SUITE_ADD_TEST(suite, TestBloomDeserializeRejectsHashCount);
+    SUITE_ADD_TEST(suite, TestBloomDistinctProbes);
+    SUITE_ADD_TEST(suite, TestBSTCreate);
+    SUITE_ADD_TEST(suite, TestBSTAdd);
+    SUITE_ADD_TEST(suite, TestBSTAddSameElement);
+    SUITE_ADD_TEST(suite, TestBSTFindElement);
+    SUITE_ADD_TEST(suite, TestBSTFindElementThatDoesNotExist);
+    SUITE_ADD_TEST(suite, TestBSTFindElementOnEmptyContainer);
+    SUITE_ADD_TEST(suite, TestBSTForEach);
+    SUITE_ADD_TEST(suite, TestBSTForEachInOrder);
+    SUITE_ADD_TEST(suite, TestBSTForEachReverseOrder);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNodeEmptyTree);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNodeNoChildren);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNodeOnlyLeftChild);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNodeOnlyRightChild);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNodeWithTwoChildren);
+    SUITE_ADD_TEST(suite, TestBSTRemoveLeafNode);
+    SUITE_ADD_TEST(suite, TestBSTRemoveNull);
+    SUITE_ADD_TEST(suite, TestBSTCreateWithAllocator);
+    SUITE_ADD_TEST(suite, TestBSTRemoveRootWithDeepSuccessor);
+    SUITE_ADD_TEST(suite, TestBSTIterator);
+    SUITE_ADD_TEST(suite, TestBSTBalancedSortedAdd);
+    SUITE_ADD_TEST(suite, TestBSTBalancedRemove);
+    SUITE_ADD_TEST(suite, TestFlatSetCreate);
+    SUITE_ADD_TEST(suite, TestFlatSetCreateSizedZeroSize);
+    SUITE_ADD_TEST(suite, TestFlatSetAddKeepsOrder);
+    SUITE_ADD_TEST(suite, TestFlatSetAddDuplicate);
+    SUITE_ADD_TEST(suite, TestFlatSetFind);
+    SUITE_ADD_TEST(suite, TestFlatSetRm);
+    SUITE_ADD_TEST(suite, TestHBitSetConstruction);
+    SUITE_ADD_TEST(suite, TestHBitSetSetClear);
+    SUITE_ADD_TEST(suite, TestHBitSetFindNext);
+    SUITE_ADD_TEST(suite, TestHBitSetForEach);
+    SUITE_ADD_TEST(suite, TestSoaCreate);
+    SUITE_ADD_TEST(suite, TestSoaCreateInvalid);
+    SUITE_ADD_TEST(suite, TestSoaAddAndScan);
+    SUITE_ADD_TEST(suite, TestSoaRemoveAt);
+    SUITE_ADD_TEST(suite, TestThreadPoolCreate);
+    SUITE_ADD_TEST(suite, TestThreadPoolReuse);
+    SUITE_ADD_TEST(suite, TestTypedVectorInit);
+    SUITE_ADD_TEST(suite, TestTypedVectorAddAndAt);
+    SUITE_ADD_TEST(suite, TestTypedVectorFind);
+    SUITE_ADD_TEST(suite, TestTypedVectorRm);
+    SUITE_ADD_TEST(suite, TestTypedVectorReserveAndShrink);
+    SUITE_ADD_TEST(suite, TestTypedVectorGrowFromCapacityOne);
+    SUITE_ADD_TEST(suite, TestTypedVectorCustomEq);
+    SUITE_ADD_TEST(suite, TestTypedVectorCreateWithAllocator);
+    SUITE_ADD_TEST(suite, TestVectorInitNullAlloc);
+    SUITE_ADD_TEST(suite, TestVectorAddElem);
+    SUITE_ADD_TEST(suite, TestVectorForEach);
+    SUITE_ADD_TEST(suite, TestVectorAt);
+    SUITE_ADD_TEST(suite, TestVectorAtOutOfRange);
+    SUITE_ADD_TEST(suite, TestVectorFindElementExists);
+    SUITE_ADD_TEST(suite, TestVectorFindElementDoesNotExist);
+    SUITE_ADD_TEST(suite, TestVectorRmEmpty);
+    SUITE_ADD_TEST(suite, TestVectorRmNotEmptyAndExists);
+    SUITE_ADD_TEST(suite, TestVectorRmNotEmptyAndDoesNotExist);
+    SUITE_ADD_TEST(suite, TestVectorRmAtEmpty);
+    SUITE_ADD_TEST(suite, TestVectorRmAtNotEmptyAndExists);
+    SUITE_ADD_TEST(suite, TestVectorRmAtNotEmptyAndOutOfRange);
+    SUITE_ADD_TEST(suite, TestVectorEmptyOnEmpty);
+    SUITE_ADD_TEST(suite, TestVectorEmptyOnNonEmpty);
+    SUITE_ADD_TEST(suite, TestVectorReserve);
+    SUITE_ADD_TEST(suite, TestVectorReserveLessThanElemCount);
+    SUITE_ADD_TEST(suite, TestVectorShrinkToFit);
+    SUITE_ADD_TEST(suite, TestVectorSizedInitZeroSize);
+    SUITE_ADD_TEST(suite, TestVectorSizedAddAndAt);
+    SUITE_ADD_TEST(suite, TestVectorSizedFind);
+    SUITE_ADD_TEST(suite, TestVectorSizedRm);
+    SUITE_ADD_TEST(suite, TestVectorRmReturnsRemovedElement);
+    SUITE_ADD_TEST(suite, TestVectorSizedForEach);
+    SUITE_ADD_TEST(suite, TestVectorFindInt);
+    SUITE_ADD_TEST(suite, TestVectorFindIntReturnsFirstMatch);
+    SUITE_ADD_TEST(suite, TestVectorFindIntPointerStorage);
+    SUITE_ADD_TEST(suite, TestVectorIntFunctionsRejectOtherSizes);
+    SUITE_ADD_TEST(suite, TestVectorAddN);
+    SUITE_ADD_TEST(suite, TestVectorSizedAddN);
+    SUITE_ADD_TEST(suite, TestVectorCreateFrom);
+    SUITE_ADD_TEST(suite, TestVectorAdopt);
+    SUITE_ADD_TEST(suite, TestVectorAdoptSizeGreaterThanCapacity);
+    SUITE_ADD_TEST(suite, TestVectorSortPointers);
+    SUITE_ADD_TEST(suite, TestVectorSortSizedWithDuplicates);
+    SUITE_ADD_TEST(suite, TestVectorSortAlreadySorted);
+    SUITE_ADD_TEST(suite, TestVectorSortInt);
+    SUITE_ADD_TEST(suite, TestVectorSortIntSmall);
+    SUITE_ADD_TEST(suite, TestVectorParallelForEach);
+    SUITE_ADD_TEST(suite, TestVectorParallelSort);
+    SUITE_ADD_TEST(suite, TestVectorParallelSortPointers);
+    SUITE_ADD_TEST(suite, TestVectorParallelWithPool);
+    SUITE_ADD_TEST(suite, TestVectorInsert);
+    SUITE_ADD_TEST(suite, TestVectorBounds);
+    SUITE_ADD_TEST(suite, TestVectorBoundsEmpty);
+    SUITE_ADD_TEST(suite, TestVectorBSearch);
+    SUITE_ADD_TEST(suite, TestVectorRmAtOrdered);
+    SUITE_ADD_TEST(suite, TestVectorRmAtOrderedPointers);
+    SUITE_ADD_TEST(suite, TestVectorRmRange);
+    SUITE_ADD_TEST(suite, TestVectorEraseIf);
+    SUITE_ADD_TEST(suite, TestVectorCreateWithAllocator);
+    SUITE_ADD_TEST(suite, TestVectorCreateWithCapacity);
+    SUITE_ADD_TEST(suite, TestVectorConstructorsWithAllocator);
+    SUITE_ADD_TEST(suite, TestVectorDefaultGrowth);
+    SUITE_ADD_TEST(suite, TestVectorCreateWithGrowth);
+    SUITE_ADD_TEST(suite, TestVectorSetGrowth);
+    SUITE_ADD_TEST(suite, TestVectorSetGrowthPageRounding);
+    SUITE_ADD_TEST(suite, TestVectorSetGrowthInvalid);
+    SUITE_ADD_TEST(suite, TestVectorIterator);
+    SUITE_ADD_TEST(suite, TestVectorIteratorSized);
+    SUITE_ADD_TEST(suite, TestVectorMappedPersists);
+    SUITE_ADD_TEST(suite, TestVectorMappedRejectsMismatch);
+    SUITE_ADD_TEST(suite, TestVectorSmallSingleAllocation);
+    SUITE_ADD_TEST(suite, TestVectorSizedSmall);
+
+    CuSuiteRun(suite);
+    CuSuiteSummary(suite, output);
+    CuSuiteDetails(suite, output);
+    printf("%s\n", output->buffer);
+    CuStringDelete(output);
+    CuSuiteDelete(suite);
+}
+
+int main(void)
+{
+    RunAllTests();
+}
+